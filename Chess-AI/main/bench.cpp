@@ -0,0 +1,45 @@
+#include <chrono>
+#include <algorithm>
+#include "bench.h"
+#include "chessAI.h"
+#include "gameState/gameState.h"
+#include "move.h"
+
+unsigned long long runBench(int depth, std::ostream& output) {
+	ChessAI::setThreadCount(1);
+	ChessAI::setTranspositionTableSize(BENCH_TRANSPOSITION_TABLE_SIZE);
+
+	unsigned long long totalNodes = 0;
+	auto startTime = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < BENCH_POSITION_COUNT; i++) {
+		GameState state;
+		if (!GameState::fromFEN(BENCH_POSITIONS[i], state)) {
+			output << "Invalid FEN: " << BENCH_POSITIONS[i] << std::endl;
+			continue;
+		}
+
+		// Every position is searched from a clean table and history without time limit, so the node counts are deterministic
+		ChessAI::clearTranspositionTable();
+		ChessAI::clearSearchHistory();
+		SearchLimits limits;
+		limits.maxDepth = depth;
+		unsigned long long nodes = 0;
+		limits.infoCallback = [&nodes](const SearchInfo& info) {
+			nodes = info.nodes;
+		};
+		Move bestMove = ChessAI::findBestMove(state, limits).bestMove;
+
+		totalNodes += nodes;
+		output << "Position " << (i + 1) << "/" << BENCH_POSITION_COUNT << ": " << BENCH_POSITIONS[i]
+			<< " bestmove " << bestMove.toString() << " nodes " << nodes << std::endl;
+	}
+
+	long long time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+	output << "\nTotal time (ms) : " << time << "\n";
+	output << "Nodes searched  : " << totalNodes << "\n";
+	output << "Nodes/second    : " << totalNodes * 1000 / std::max(1LL, time) << "\n";
+	output << "Signature       : " << totalNodes << std::endl;
+
+	return totalNodes;
+}
@@ -0,0 +1,50 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <ostream>
+
+/// <summary>
+/// The default search depth of the bench.
+/// </summary>
+constexpr auto BENCH_DEFAULT_DEPTH = 6;
+
+/// <summary>
+/// The transposition table size in megabytes the bench is run with, so the node counts don't depend on the Hash option.
+/// </summary>
+constexpr auto BENCH_TRANSPOSITION_TABLE_SIZE = 16;
+
+/// <summary>
+/// The amount of positions searched by the bench.
+/// </summary>
+constexpr auto BENCH_POSITION_COUNT = 10;
+
+/// <summary>
+/// The FEN strings of the positions searched by the bench (openings, middlegames and endgames).
+/// </summary>
+constexpr const char* BENCH_POSITIONS[BENCH_POSITION_COUNT] = {
+	"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+	"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+	"r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+	"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+	"r1bq1rk1/pp2bppp/2n1pn2/2pp4/3P4/2PBPN2/PP1N1PPP/R1BQ1RK1 w - - 0 8",
+	"2r3k1/pp3ppp/4p3/3pP3/3P1P2/P2Q4/1q4PP/5RK1 b - - 0 25",
+	"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+	"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+	"6k1/5pp1/4p2p/3pP3/3P1P2/6P1/r4K1P/2R5 w - - 0 35",
+	"8/8/4k3/8/2p5/8/B2K4/8 w - - 0 1"
+};
+
+/// <summary>
+/// Searches every bench position to the given depth with one search thread and a cleared transposition table
+/// of BENCH_TRANSPOSITION_TABLE_SIZE megabytes, and writes the nodes of every position and the total nodes,
+/// time and nodes per second to the output. The total node count is the signature of the search: it only changes
+/// when the search itself changes.
+/// Leaves the search with one thread and the bench transposition table size, so the caller has to restore its settings.
+/// Must not be called while a best move search is running.
+/// </summary>
+/// <param name="depth">The search depth</param>
+/// <param name="output">The stream to write the results to</param>
+/// <returns>The total amount of searched nodes (the signature)</returns>
+unsigned long long runBench(int depth, std::ostream& output);
+
+#endif
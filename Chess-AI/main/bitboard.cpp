@@ -0,0 +1,183 @@
+#include "bitboard.h"
+
+uint64_t Bitboards::_knightAttacks[64];
+uint64_t Bitboards::_kingAttacks[64];
+uint64_t Bitboards::_pawnAttacks[2][64];
+MagicEntry Bitboards::_bishopMagics[64];
+MagicEntry Bitboards::_rookMagics[64];
+uint64_t Bitboards::_bishopAttackTable[5248];
+uint64_t Bitboards::_rookAttackTable[102400];
+uint64_t Bitboards::_betweenSquares[64][64];
+uint64_t Bitboards::_lineSquares[64][64];
+
+const bool Bitboards::_initialized = Bitboards::initialize();
+
+/// <summary>
+/// The X and Y steps of the diagonal ray directions.
+/// </summary>
+const int bishopDirections[4][2] = { {-1, 1}, {-1, -1}, {1, 1}, {1, -1} };
+
+/// <summary>
+/// The X and Y steps of the straight ray directions.
+/// </summary>
+const int rookDirections[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+
+/// <summary>
+/// The bishop magic numbers of each square. The numbers were found with a sparse random search
+/// that accepts a number when it maps every relevant occupancy of the square without destructive collisions.
+/// </summary>
+const uint64_t bishopMagicNumbers[64] = {
+    0x10102002004A1420ULL, 0x8020040400584008ULL, 0x10510800811201C8ULL, 0x5204042080000088ULL,
+    0x2204106880000002ULL, 0x1401042004000000ULL, 0x0400880410042004ULL, 0x0028208200A02020ULL,
+    0x1500241990010E00ULL, 0x8001200182020A40ULL, 0x40004101030B0000ULL, 0x8002041042000100ULL,
+    0x4010011041020038ULL, 0x0000010421044000ULL, 0x1500210808020A00ULL, 0x8000088400880520ULL,
+    0x0405004010040100ULL, 0x1005823210040108ULL, 0x2708008102040011ULL, 0x4048200404009100ULL,
+    0x0018104101400024ULL, 0x0003000601190101ULL, 0x8004803108491000ULL, 0x8014241200820800ULL,
+    0x0006E080100C3040ULL, 0x0501044A11041800ULL, 0x9020300008004045ULL, 0x0894080000220040ULL,
+    0x1001010083104000ULL, 0x5004030040900080ULL, 0x000400422C012400ULL, 0x0002128698404812ULL,
+    0x1010108404900440ULL, 0x0928021182084100ULL, 0x2006080409020024ULL, 0x1010202020180080ULL,
+    0xA010008200202200ULL, 0x2098015100019004ULL, 0x0002041440810811ULL, 0x802A02020000B098ULL,
+    0x0009015090004060ULL, 0x4000821082081001ULL, 0x0100210040420800ULL, 0x0800004010488A00ULL,
+    0x2000081104004040ULL, 0x4C8E029015000082ULL, 0x0420340322224842ULL, 0x1298260043400210ULL,
+    0x0000822802400008ULL, 0x00008A0101600000ULL, 0x3040003412080021ULL, 0x3040290220884800ULL,
+    0x4A1500401041004AULL, 0x8010200282020781ULL, 0x0020203142209091ULL, 0x0070300600902110ULL,
+    0x0040808800B62048ULL, 0x0000810400C44420ULL, 0x00080400440C0441ULL, 0x8340080020840411ULL,
+    0x0000000104208200ULL, 0x0000800810D00080ULL, 0x0400530411080200ULL, 0x4040702400932244ULL
+};
+
+/// <summary>
+/// The rook magic numbers of each square. The numbers were found with the same search as the bishop magic numbers.
+/// </summary>
+const uint64_t rookMagicNumbers[64] = {
+    0x1080004008801020ULL, 0x0840092002C03000ULL, 0x1900200010400900ULL, 0x0880100008000480ULL,
+    0x4200100420080200ULL, 0x8100020100080400ULL, 0x0200040110886200ULL, 0x0200008040220411ULL,
+    0x0404800084400220ULL, 0x0000401000402000ULL, 0x0086001081220440ULL, 0x0408800800100280ULL,
+    0x000A001201040820ULL, 0x8848800200840080ULL, 0x4001000100040200ULL, 0x0442000102105084ULL,
+    0x9080010020804100ULL, 0x0040404000201009ULL, 0x0000808010002009ULL, 0x2200090021D00100ULL,
+    0x0008008008040080ULL, 0x0004004002010040ULL, 0x0011040008015042ULL, 0x00000A0001768104ULL,
+    0x0000800080204009ULL, 0x2010004140002001ULL, 0x9800200280100080ULL, 0x1000100080080080ULL,
+    0x0442000A00049020ULL, 0x2100040080020080ULL, 0x0800120400900148ULL, 0x0010040A00128541ULL,
+    0x2800804000800030ULL, 0x1010002000400041ULL, 0x4000200011004100ULL, 0x0610008410800800ULL,
+    0x0400802402800800ULL, 0xC100020080800400ULL, 0x0002000802000401ULL, 0x0182085882000401ULL,
+    0x0220204000808000ULL, 0x2860100040024022ULL, 0x0001002004110040ULL, 0x99101042000A0020ULL,
+    0x0004080004008080ULL, 0x0010040002008080ULL, 0x2012004881020004ULL, 0x8300842444820011ULL,
+    0x0088403882010200ULL, 0x0820400080210100ULL, 0x0110910040A00300ULL, 0x0801100280080480ULL,
+    0x0242009008200600ULL, 0x1002000489500200ULL, 0x0040800200010080ULL, 0x0091800041000080ULL,
+    0x0000209300488001ULL, 0x04C1002414824001ULL, 0x020020000B001041ULL, 0x7000100004200901ULL,
+    0x8002002004100802ULL, 0x30010002084C0007ULL, 0x0888221800813004ULL, 0x4000002840840112ULL
+};
+
+bool Bitboards::initialize() {
+    const int knightSteps[8][2] = { {-2, 1}, {-1, 2}, {1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1} };
+    const int kingSteps[8][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1}, {-1, -1}, {-1, 1}, {1, -1}, {1, 1} };
+
+    for (int square = 0; square < 64; square++) {
+        int x = square % 8;
+        int y = square / 8;
+
+        // Knight and king attacks
+        _knightAttacks[square] = 0;
+        _kingAttacks[square] = 0;
+        for (int i = 0; i < 8; i++) {
+            int knightX = x + knightSteps[i][0];
+            int knightY = y + knightSteps[i][1];
+            if (knightX >= 0 && knightX <= 7 && knightY >= 0 && knightY <= 7) {
+                _knightAttacks[square] |= squareBitboard(squareIndex(knightX, knightY));
+            }
+
+            int kingX = x + kingSteps[i][0];
+            int kingY = y + kingSteps[i][1];
+            if (kingX >= 0 && kingX <= 7 && kingY >= 0 && kingY <= 7) {
+                _kingAttacks[square] |= squareBitboard(squareIndex(kingX, kingY));
+            }
+        }
+
+        // Pawn attacks (white pawns move up and black pawns down)
+        _pawnAttacks[0][square] = 0;
+        _pawnAttacks[1][square] = 0;
+        for (int pawnX = x - 1; pawnX <= x + 1; pawnX += 2) {
+            if (pawnX < 0 || pawnX > 7)
+                continue;
+
+            if (y > 0) {
+                _pawnAttacks[0][square] |= squareBitboard(squareIndex(pawnX, y - 1));
+            }
+            if (y < 7) {
+                _pawnAttacks[1][square] |= squareBitboard(squareIndex(pawnX, y + 1));
+            }
+        }
+    }
+
+    // Sliding piece attack tables
+    initializeMagics(_bishopMagics, bishopMagicNumbers, _bishopAttackTable, bishopDirections);
+    initializeMagics(_rookMagics, rookMagicNumbers, _rookAttackTable, rookDirections);
+
+    // The squares between and through the squares on the same lines (the other items stay 0)
+    for (int from = 0; from < 64; from++) {
+        for (const auto& direction : kingSteps) {
+            // The whole line of the direction through the square
+            uint64_t line = squareBitboard(from);
+            for (int sign = -1; sign <= 1; sign += 2) {
+                for (int x = from % 8 + sign * direction[0], y = from / 8 + sign * direction[1]; x >= 0 && x <= 7 && y >= 0 && y <= 7; x += sign * direction[0], y += sign * direction[1]) {
+                    line |= squareBitboard(squareIndex(x, y));
+                }
+            }
+
+            // Walk the ray of the direction and collect the squares passed before each square
+            uint64_t passed = 0;
+            for (int x = from % 8 + direction[0], y = from / 8 + direction[1]; x >= 0 && x <= 7 && y >= 0 && y <= 7; x += direction[0], y += direction[1]) {
+                int to = squareIndex(x, y);
+                _betweenSquares[from][to] = passed;
+                _lineSquares[from][to] = line;
+                passed |= squareBitboard(to);
+            }
+        }
+    }
+
+    return true;
+}
+
+uint64_t Bitboards::slidingAttacks(int square, uint64_t occupancy, const int directions[4][2]) {
+    uint64_t attacks = 0;
+    for (int i = 0; i < 4; i++) {
+        int x = square % 8;
+        int y = square / 8;
+        while (true) {
+            x += directions[i][0];
+            y += directions[i][1];
+            if (x < 0 || x > 7 || y < 0 || y > 7)
+                break;
+
+            attacks |= squareBitboard(squareIndex(x, y));
+            if (occupancy & squareBitboard(squareIndex(x, y)))
+                break;
+        }
+    }
+
+    return attacks;
+}
+
+void Bitboards::initializeMagics(MagicEntry magics[64], const uint64_t magicNumbers[64], uint64_t* attackTable, const int directions[4][2]) {
+    uint64_t* squareAttacks = attackTable;
+    for (int square = 0; square < 64; square++) {
+        MagicEntry& entry = magics[square];
+
+        // The board edges don't affect the attacks unless the square itself is at the edge
+        uint64_t edges = ((0x00000000000000FFULL | 0xFF00000000000000ULL) & ~(0x00000000000000FFULL << (square / 8 * 8)))
+            | ((0x0101010101010101ULL | 0x8080808080808080ULL) & ~(0x0101010101010101ULL << (square % 8)));
+
+        entry.mask = slidingAttacks(square, 0, directions) & ~edges;
+        entry.magic = magicNumbers[square];
+        entry.shift = 64 - squareCount(entry.mask);
+        entry.attacks = squareAttacks;
+
+        // Enumerate all subsets of the mask with the carry-rippler trick and store their attacks
+        uint64_t occupancy = 0;
+        do {
+            squareAttacks[entry.index(occupancy)] = slidingAttacks(square, occupancy, directions);
+            occupancy = (occupancy - entry.mask) & entry.mask;
+        } while (occupancy);
+
+        squareAttacks += 1ULL << squareCount(entry.mask);
+    }
+}
@@ -0,0 +1,283 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/// <summary>
+/// Returns the square index of the given internal index coordinates.
+/// Bit n of a bitboard describes the square at X coordinate n % 8 and Y coordinate n / 8.
+/// </summary>
+/// <param name="x">The X coordinate of the square</param>
+/// <param name="y">The Y coordinate of the square</param>
+/// <returns>The square index</returns>
+inline int squareIndex(int x, int y) {
+	return y * 8 + x;
+}
+
+/// <summary>
+/// Returns a bitboard that has only the given square set.
+/// </summary>
+/// <param name="square">The square index</param>
+/// <returns>The bitboard of the square</returns>
+inline uint64_t squareBitboard(int square) {
+	return 1ULL << square;
+}
+
+/// <summary>
+/// Returns the index of the least significant set square of the bitboard.
+/// The bitboard must not be empty!
+/// </summary>
+/// <param name="bitboard">The bitboard</param>
+/// <returns>The least significant square index</returns>
+inline int leastSignificantSquare(uint64_t bitboard) {
+#if defined(_MSC_VER) && defined(_WIN64)
+	unsigned long index;
+	_BitScanForward64(&index, bitboard);
+	return static_cast<int>(index);
+#elif defined(_MSC_VER)
+	unsigned long index;
+	if (_BitScanForward(&index, static_cast<unsigned long>(bitboard))) {
+		return static_cast<int>(index);
+	}
+	_BitScanForward(&index, static_cast<unsigned long>(bitboard >> 32));
+	return static_cast<int>(index) + 32;
+#else
+	return __builtin_ctzll(bitboard);
+#endif
+}
+
+/// <summary>
+/// Removes the least significant set square from the bitboard and returns its index.
+/// The bitboard must not be empty!
+/// </summary>
+/// <param name="bitboard">The bitboard to pop the square from</param>
+/// <returns>The popped square index</returns>
+inline int popLeastSignificantSquare(uint64_t& bitboard) {
+	int square = leastSignificantSquare(bitboard);
+	bitboard &= bitboard - 1;
+	return square;
+}
+
+/// <summary>
+/// Counts the set squares of the bitboard.
+/// </summary>
+/// <param name="bitboard">The bitboard</param>
+/// <returns>The amount of set squares</returns>
+inline int squareCount(uint64_t bitboard) {
+#if defined(_MSC_VER)
+	bitboard = bitboard - ((bitboard >> 1) & 0x5555555555555555ULL);
+	bitboard = (bitboard & 0x3333333333333333ULL) + ((bitboard >> 2) & 0x3333333333333333ULL);
+	bitboard = (bitboard + (bitboard >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return static_cast<int>((bitboard * 0x0101010101010101ULL) >> 56);
+#else
+	return __builtin_popcountll(bitboard);
+#endif
+}
+
+/// <summary>
+/// The magic bitboard lookup data of one square for one sliding piece type.
+/// The attacks of the square are found from the attack table with index
+/// ((occupancy &amp; mask) * magic) &gt;&gt; shift.
+/// </summary>
+struct MagicEntry {
+	/// <summary>
+	/// The squares whose occupancy affects the attacks of the square (the rays without the board edges).
+	/// </summary>
+	uint64_t mask;
+
+	/// <summary>
+	/// The magic multiplier that maps every relevant occupancy to a unique (or constructively colliding) index.
+	/// </summary>
+	uint64_t magic;
+
+	/// <summary>
+	/// The first attack table item of the square.
+	/// </summary>
+	uint64_t* attacks;
+
+	/// <summary>
+	/// The amount the multiplied occupancy is shifted to get the table index.
+	/// </summary>
+	int shift;
+
+	/// <summary>
+	/// Calculates the attack table index of the given occupancy.
+	/// </summary>
+	/// <param name="occupancy">The occupied squares of the board</param>
+	/// <returns>The attack table index</returns>
+	unsigned int index(uint64_t occupancy) const {
+		return static_cast<unsigned int>(((occupancy & mask) * magic) >> shift);
+	}
+};
+
+/// <summary>
+/// Precalculated attack bitboards that are shared by move generation and attack detection.
+/// Sliding piece attacks are looked up from magic bitboard tables.
+/// The tables are initialized automatically at program start.
+/// </summary>
+class Bitboards {
+
+private:
+	/// <summary>
+	/// The squares a knight attacks from each square.
+	/// </summary>
+	static uint64_t _knightAttacks[64];
+
+	/// <summary>
+	/// The squares a king attacks from each square.
+	/// </summary>
+	static uint64_t _kingAttacks[64];
+
+	/// <summary>
+	/// The squares a pawn attacks from each square (index 0 = white pawn, 1 = black pawn).
+	/// </summary>
+	static uint64_t _pawnAttacks[2][64];
+
+	/// <summary>
+	/// The magic bitboard lookup data of bishops for each square.
+	/// </summary>
+	static MagicEntry _bishopMagics[64];
+
+	/// <summary>
+	/// The magic bitboard lookup data of rooks for each square.
+	/// </summary>
+	static MagicEntry _rookMagics[64];
+
+	/// <summary>
+	/// The bishop attacks of all squares and relevant occupancies.
+	/// </summary>
+	static uint64_t _bishopAttackTable[5248];
+
+	/// <summary>
+	/// The rook attacks of all squares and relevant occupancies.
+	/// </summary>
+	static uint64_t _rookAttackTable[102400];
+
+	/// <summary>
+	/// The squares between two squares on the same straight or diagonal line (the squares themselves not included),
+	/// or 0 if the squares are not on the same line.
+	/// </summary>
+	static uint64_t _betweenSquares[64][64];
+
+	/// <summary>
+	/// The squares of the whole straight or diagonal line going through two squares (from board edge to board edge),
+	/// or 0 if the squares are not on the same line.
+	/// </summary>
+	static uint64_t _lineSquares[64][64];
+
+	/// <summary>
+	/// Flag that is set when the tables have been initialized.
+	/// </summary>
+	static const bool _initialized;
+
+	/// <summary>
+	/// Calculates the attack tables.
+	/// </summary>
+	/// <returns>True when the tables are initialized</returns>
+	static bool initialize();
+
+	/// <summary>
+	/// Calculates the sliding attacks from the given square to the given directions by walking the rays.
+	/// The rays stop at the first occupied square, which is included in the attacks.
+	/// </summary>
+	/// <param name="square">The square index of the sliding piece</param>
+	/// <param name="occupancy">The occupied squares of the board</param>
+	/// <param name="directions">The X and Y steps of the four ray directions</param>
+	/// <returns>The attacked squares</returns>
+	static uint64_t slidingAttacks(int square, uint64_t occupancy, const int directions[4][2]);
+
+	/// <summary>
+	/// Initializes the magic lookup data of all squares for a sliding piece and fills the attack table.
+	/// </summary>
+	/// <param name="magics">The magic lookup data to initialize</param>
+	/// <param name="magicNumbers">The magic numbers of the squares</param>
+	/// <param name="attackTable">The attack table to fill</param>
+	/// <param name="directions">The X and Y steps of the four ray directions of the piece</param>
+	static void initializeMagics(MagicEntry magics[64], const uint64_t magicNumbers[64], uint64_t* attackTable, const int directions[4][2]);
+
+public:
+	/// <summary>
+	/// The squares a knight attacks from the given square.
+	/// </summary>
+	/// <param name="square">The square index of the knight</param>
+	/// <returns>The attacked squares</returns>
+	static uint64_t knightAttacks(int square) {
+		return _knightAttacks[square];
+	}
+
+	/// <summary>
+	/// The squares a king attacks from the given square.
+	/// </summary>
+	/// <param name="square">The square index of the king</param>
+	/// <returns>The attacked squares</returns>
+	static uint64_t kingAttacks(int square) {
+		return _kingAttacks[square];
+	}
+
+	/// <summary>
+	/// The squares a pawn of the given color attacks from the given square.
+	/// </summary>
+	/// <param name="isWhite">If the pawn is white</param>
+	/// <param name="square">The square index of the pawn</param>
+	/// <returns>The attacked squares</returns>
+	static uint64_t pawnAttacks(bool isWhite, int square) {
+		return _pawnAttacks[isWhite ? 0 : 1][square];
+	}
+
+	/// <summary>
+	/// The squares a bishop attacks from the given square with the given board occupancy.
+	/// </summary>
+	/// <param name="square">The square index of the bishop</param>
+	/// <param name="occupancy">The occupied squares of the board</param>
+	/// <returns>The attacked squares</returns>
+	static uint64_t bishopAttacks(int square, uint64_t occupancy) {
+		return _bishopMagics[square].attacks[_bishopMagics[square].index(occupancy)];
+	}
+
+	/// <summary>
+	/// The squares a rook attacks from the given square with the given board occupancy.
+	/// </summary>
+	/// <param name="square">The square index of the rook</param>
+	/// <param name="occupancy">The occupied squares of the board</param>
+	/// <returns>The attacked squares</returns>
+	static uint64_t rookAttacks(int square, uint64_t occupancy) {
+		return _rookMagics[square].attacks[_rookMagics[square].index(occupancy)];
+	}
+
+	/// <summary>
+	/// The squares a queen attacks from the given square with the given board occupancy.
+	/// </summary>
+	/// <param name="square">The square index of the queen</param>
+	/// <param name="occupancy">The occupied squares of the board</param>
+	/// <returns>The attacked squares</returns>
+	static uint64_t queenAttacks(int square, uint64_t occupancy) {
+		return bishopAttacks(square, occupancy) | rookAttacks(square, occupancy);
+	}
+
+	/// <summary>
+	/// The squares between the given squares if they are on the same straight or diagonal line.
+	/// </summary>
+	/// <param name="from">The first square index</param>
+	/// <param name="to">The second square index</param>
+	/// <returns>The squares between the squares (the squares themselves not included), or 0 if the squares are not on the same line</returns>
+	static uint64_t betweenSquares(int from, int to) {
+		return _betweenSquares[from][to];
+	}
+
+	/// <summary>
+	/// The squares of the straight or diagonal line going through the given squares.
+	/// </summary>
+	/// <param name="from">The first square index</param>
+	/// <param name="to">The second square index</param>
+	/// <returns>The squares of the line from board edge to board edge, or 0 if the squares are not on the same line</returns>
+	static uint64_t lineSquares(int from, int to) {
+		return _lineSquares[from][to];
+	}
+
+};
+
+#endif
@@ -1,124 +1,806 @@
 #include "chessAI.h"  
 #include "piece.h" 
+#include "movePicker.h"
 #include <limits>  
 #include <thread>
-#include <vector>
 #include <algorithm>
 #include <iostream>
+#include <cstdlib>
+#include <cmath>
 
-std::atomic<int> ChessAI::bestValue;
-std::atomic<int> ChessAI::bestValueGameStateIndex;
-std::atomic<bool> ChessAI::timeExceeded;
+std::atomic<bool> ChessAI::stopSearch;
+std::mutex ChessAI::stopMutex;
+std::condition_variable ChessAI::stopCondition;
+bool ChessAI::stopRequested = false;
+bool ChessAI::pondering = false;
+std::thread ChessAI::backgroundSearchThread;
+std::chrono::steady_clock::time_point ChessAI::searchStartTime;
 
-TranspositionTable<30000000> ChessAI::transpositionTable;
+TranspositionTable ChessAI::transpositionTable;
+ThreadPool ChessAI::threadPool;
+bool ChessAI::threadCountSet = false;
+std::unique_ptr<SplitPointQueue[]> ChessAI::splitPointQueues;
+std::mutex ChessAI::idleHelperMutex;
+std::condition_variable ChessAI::idleHelperCondition;
+std::atomic<unsigned long long> ChessAI::idleHelperNotificationCount{ 0 };
+std::atomic<int> ChessAI::mainThreadDepth{ 0 };
+std::unique_ptr<NodeCounter[]> ChessAI::nodeCounters;
+std::unique_ptr<SearchHistory[]> ChessAI::searchHistories;
+std::atomic<unsigned long long> ChessAI::rootMoveNodes[MAX_MOVES];
+int ChessAI::lateMoveReductions[64][64];
+const bool ChessAI::lateMoveReductionsInitialized = ChessAI::initializeLateMoveReductions();
+thread_local int ChessAI::searchThreadIndex = 0;
+thread_local const SplitPoint* ChessAI::activeSplitPoint = nullptr;
+thread_local bool ChessAI::helperRootSearch = false;
+thread_local unsigned long long ChessAI::helperRootSearchNotificationCount = 0;
+
+void SearchHistory::clear() {
+    for (auto& plyKillerMoves : killerMoves) {
+        for (Move& killerMove : plyKillerMoves) {
+            killerMove = Move(0, 0, 0, 0);
+        }
+    }
+    for (auto& pieceCounterMoves : counterMoves) {
+        for (Move& counterMove : pieceCounterMoves) {
+            counterMove = Move(0, 0, 0, 0);
+        }
+    }
+    std::fill(&historyScores[0][0][0], &historyScores[0][0][0] + 2 * 64 * 64, 0);
+}
+
+void SearchHistory::newSearch() {
+    for (auto& plyKillerMoves : killerMoves) {
+        for (Move& killerMove : plyKillerMoves) {
+            killerMove = Move(0, 0, 0, 0);
+        }
+    }
+    for (int* score = &historyScores[0][0][0]; score != &historyScores[0][0][0] + 2 * 64 * 64; score++) {
+        *score /= 2;
+    }
+}
+
+void SearchHistory::updateCutoff(const GameState& state, const Move& move, int ply, int depth, const Move* searchedQuietMoves, int searchedQuietMoveCount) {
+    // Keep the killer moves different, so a repeated cutoff doesn't push out the other killer move
+    if (killerMoves[ply][0] != move) {
+        for (int i = KILLER_MOVE_COUNT - 1; i > 0; i--) {
+            killerMoves[ply][i] = killerMoves[ply][i - 1];
+        }
+        killerMoves[ply][0] = move;
+    }
+
+    // The deeper the cutoff, the more it tells about the move. The gravity term keeps the scores within the limit
+    // and lets the scores of the moves that stop producing cutoffs decrease
+    int (&scores)[64][64] = historyScores[state.isWhiteSideToMove() ? 0 : 1];
+    int bonus = std::min(depth * depth, MAX_HISTORY_SCORE);
+    int& score = scores[move.fromSquare()][move.toSquare()];
+    score += bonus - score * bonus / MAX_HISTORY_SCORE;
+    for (int i = 0; i < searchedQuietMoveCount; i++) {
+        int& penalizedScore = scores[searchedQuietMoves[i].fromSquare()][searchedQuietMoves[i].toSquare()];
+        penalizedScore -= bonus + penalizedScore * bonus / MAX_HISTORY_SCORE;
+    }
+
+    // The moved piece is on the to square of the previous move (there is no previous move after a null move)
+    Move lastMove = state.lastMove();
+    if (lastMove != Move(0, 0, 0, 0)) {
+        counterMoves[state.getPieceAt(lastMove.x2(), lastMove.y2())][lastMove.toSquare()] = move;
+    }
+}
+
+Move SearchHistory::counterMove(const GameState& state) const {
+    Move lastMove = state.lastMove();
+    if (lastMove == Move(0, 0, 0, 0)) {
+        return Move(0, 0, 0, 0);
+    }
+    return counterMoves[state.getPieceAt(lastMove.x2(), lastMove.y2())][lastMove.toSquare()];
+}
+
+bool ChessAI::initializeLateMoveReductions() {
+    // The reduction grows slowly with both the depth and the move number
+    for (int depth = 1; depth < 64; depth++) {
+        for (int moveNumber = 1; moveNumber < 64; moveNumber++) {
+            lateMoveReductions[depth][moveNumber] = static_cast<int>(LATE_MOVE_REDUCTION_BASE + std::log(depth) * std::log(moveNumber) / LATE_MOVE_REDUCTION_DIVISOR);
+        }
+    }
+    return true;
+}
+
+int ChessAI::lateMoveReduction(const GameState& state, const Move& move, bool isCheck, int depth, int moveNumber) {
+    // Captures, promotions and checks are searched at full depth, as are all moves of a node in check
+    if (isCheck || depth < LATE_MOVE_REDUCTION_MIN_DEPTH || moveNumber < LATE_MOVE_REDUCTION_MIN_MOVE_NUMBER
+        || move.isCapture() || move.isPromotion() || state.isCheck(state.isWhiteSideToMove())) {
+        return 0;
+    }
+
+    // The reduced search must not drop directly to the quiescence search
+    return std::min(lateMoveReductions[std::min(depth, 63)][std::min(moveNumber, 63)], depth - 2);
+}
+
+int ChessAI::setTranspositionTableSize(int megabytes) {
+    return static_cast<int>(transpositionTable.resize(megabytes));
+}
+
+void ChessAI::setThreadCount(int threadCount) {
+    threadPool.resize(std::max(1, threadCount));
+    splitPointQueues.reset(new SplitPointQueue[threadPool.size()]);
+    nodeCounters.reset(new NodeCounter[threadPool.size()]);
+    searchHistories.reset(new SearchHistory[threadPool.size()]);
+    clearSearchHistory();
+    threadCountSet = true;
+}
+
+void ChessAI::clearSearchHistory() {
+    for (int i = 0; i < threadPool.size(); i++) {
+        searchHistories[i].clear();
+    }
+}
+
+void ChessAI::clearTranspositionTable() {
+    if (transpositionTable.isAllocated()) {
+        transpositionTable.clear(threadPool.size());
+    }
+}
 
 Move ChessAI::findBestMove(const GameState& state, int maxDepth, int timeLimit) {
-    std::vector<GameState> possibleStates;
-    state.possibleNewGameStates(possibleStates);
-    if (possibleStates.empty()) {
-        return Move(0, 0, 0, 0); // Return empty move as there are no moves available
+    SearchLimits limits;
+    limits.maxDepth = maxDepth;
+    limits.timeLimit = timeLimit;
+
+    // Debug output
+    limits.infoCallback = [](const SearchInfo& info) {
+        std::cout << "Depth " << info.depth << " completed. Best move: (" 
+                  << (int)info.bestMove.x1() << "," << (int)info.bestMove.y1() << ") -> (" 
+                  << (int)info.bestMove.x2() << "," << (int)info.bestMove.y2() << "). Principal variation:";
+        for (const Move& move : info.principalVariation) {
+            std::cout << " " << move.toString();
+        }
+        std::cout << ". Hashfull: " << info.hashfull << " permille" << std::endl;
+    };
+
+    return findBestMove(state, limits).bestMove;
+}
+
+SearchResult ChessAI::findBestMove(const GameState& state, const SearchLimits& limits) {
+    resetStop(limits.ponder);
+    return search(state, limits);
+}
+
+void ChessAI::startSearch(const GameState& state, const SearchLimits& limits, const std::function<void(const SearchResult&)>& onFinished) {
+    waitForSearch();
+
+    // The stop flags are reset before returning, so a stop right after this function can't be lost
+    resetStop(limits.ponder);
+    backgroundSearchThread = std::thread([state, limits, onFinished]() {
+        SearchResult result = search(state, limits);
+        if (onFinished) {
+            onFinished(result);
+        }
+    });
+}
+
+void ChessAI::waitForSearch() {
+    if (backgroundSearchThread.joinable()) {
+        backgroundSearchThread.join();
+    }
+}
+
+void ChessAI::stop() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopRequested = true;
+        pondering = false;
+        stopSearch = true;
+    }
+    stopCondition.notify_all();
+}
+
+void ChessAI::ponderhit() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        pondering = false;
+    }
+    stopCondition.notify_all();
+}
+
+void ChessAI::resetStop(bool ponder) {
+    std::lock_guard<std::mutex> lock(stopMutex);
+    stopRequested = false;
+    pondering = ponder;
+    stopSearch = false;
+}
+
+SearchResult ChessAI::search(const GameState& state, const SearchLimits& limits) {
+    searchStartTime = std::chrono::steady_clock::now();
+
+    // Allocate the transposition table and create the search threads if their sizes have not been set
+    if (!transpositionTable.isAllocated()) {
+        transpositionTable.resize(DEFAULT_TRANSPOSITION_TABLE_SIZE);
+    }
+    if (!threadCountSet) {
+        setThreadCount(static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    // Age the transposition table items of the earlier searches
+    transpositionTable.newSearch();
+
+    for (int i = 0; i < threadPool.size(); i++) {
+        nodeCounters[i].nodes = 0;
+        searchHistories[i].newSearch();
+    }
+
+    // Generate the root moves on a mutable copy of the game state
+    GameState rootState(state);
+    MoveList rootMoves;
+    rootState.legalMoves(rootMoves);
+    if (rootMoves.empty()) {
+        return SearchResult(); // Return empty move as there are no moves available
     }
 
-    // Time tracking
-    timeExceeded = false;
-    std::thread timeExceedThread([timeLimit]() {
-        std::this_thread::sleep_for(std::chrono::milliseconds(timeLimit));
-        timeExceeded = true;
+    // Time tracking (the timer stops the search when the time limit is exceeded or returns early if the search stops before it)
+    // The time limit starts when the search stops pondering
+    int timeLimit = limits.timeLimit;
+    std::thread timeLimitThread([timeLimit]() {
+        std::unique_lock<std::mutex> lock(stopMutex);
+        stopCondition.wait(lock, []() { return stopSearch || !pondering; });
+        if (timeLimit > 0) {
+            stopCondition.wait_for(lock, std::chrono::milliseconds(timeLimit), []() { return stopSearch.load(); });
+        }
+        else {
+            stopCondition.wait(lock, []() { return stopSearch.load(); });
+        }
+        stopSearch = true;
     });
-    
-    // Initialize the best move to the first possible move as a fallback
-    Move currentBestMove = possibleStates[0].lastMove();
-    
-    // Iterative deepening
-    // Start with depth 1 to quickly find mates in 1 move
-    // Then continue with depths 2, 4, 6, ... up to maxDepth
-    for (int depth = 1; depth <= maxDepth; depth = (depth == 1) ? 2 : depth + 2) {
-        // Order moves before evaluation
-        orderMoves(possibleStates, currentBestMove, state.isWhiteSideToMove());
-
-        // Reset the best value for this depth iteration
-        bestValue = std::numeric_limits<int>::min();
-        bestValueGameStateIndex = 0;
-
-        //// Code for single threaded testing
-        //std::vector<std::thread*> threads;
-        //for (int i = 0; i < possibleStates.size(); i++) {
-        //    runMinimax(possibleStates[i], i, depth - 1, state.isWhiteSideToMove());
-        //}
-        
-        // Run Minimax evaluation for every currently possible new GameState in different threads
-        std::vector<std::thread*> threads;
-        for (int i = 0; i < possibleStates.size(); i++) {
-            std::thread* thread = new std::thread(runMinimax, possibleStates[i], i, depth - 1, state.isWhiteSideToMove());
-            threads.push_back(thread);
-        }
-
-        // Wait for all threads to finish before continuing
-        for (std::thread* thread : threads) {
-            thread->join();
-            delete thread;
-        }
-
-        // Store the best move for this depth iteration if not out of time
-        if (!timeExceeded) {
-            currentBestMove = possibleStates[bestValueGameStateIndex].lastMove();
-            
-            // Debug output
-            std::cout << "Depth " << depth << " completed. Best move: (" 
-                      << (int)currentBestMove.x1() << "," << (int)currentBestMove.y1() << ") -> (" 
-                      << (int)currentBestMove.x2() << "," << (int)currentBestMove.y2() << ")" << std::endl;
-            
-            // If we found a checkmate, no need to search deeper
-            if (bestValue > 900000 || bestValue < -900000) {
+
+    // The depth is limited so that the undo record stacks of the threads can't overflow
+    SearchLimits searchLimits(limits);
+    searchLimits.maxDepth = std::max(1, std::min(limits.maxDepth, MAX_SEARCH_PLY - QUIESCENCE_SEARCH_DEPTH - 1));
+
+    // Search the root with the main thread while the other threads help it at its split points
+    mainThreadDepth = 0;
+    SearchResult result;
+    threadPool.run([&rootState, &rootMoves, &searchLimits, &result](int threadIndex) {
+        searchThreadIndex = threadIndex;
+        if (threadIndex == 0) {
+            result = searchMainThread(rootState, rootMoves, searchLimits);
+        }
+        else {
+            searchHelperThread(rootState, rootMoves, searchLimits.maxDepth);
+        }
+    });
+    timeLimitThread.join();
+
+    // An infinite or ponder search must not return before it is stopped (or the ponder move is played)
+    {
+        std::unique_lock<std::mutex> lock(stopMutex);
+        stopCondition.wait(lock, [&limits]() { return stopRequested || (!limits.infinite && !pondering); });
+    }
+
+    // Return the result of the search
+    return result;
+}
+
+unsigned long long ChessAI::searchedNodes() {
+    unsigned long long nodes = 0;
+    for (int i = 0; i < threadPool.size(); i++) {
+        nodes += nodeCounters[i].nodes.load(std::memory_order_relaxed);
+    }
+    return nodes;
+}
+
+SearchResult ChessAI::searchMainThread(const GameState& state, MoveList moves, const SearchLimits& limits) {
+    GameState searchState(state);
+    UndoRecord undoStack[MAX_SEARCH_PLY];
+
+    // Order the moves by their static evaluation for the first depth and initialize the best move
+    // to the first move as a fallback
+    orderMoves(searchState, moves, undoStack[0], Move(0, 0, 0, 0));
+    Move currentBestMove = moves[0];
+
+    // The result of the deepest completed depth (the first move and its line if no depth is completed)
+    SearchResult result;
+    result.bestMove = currentBestMove;
+    collectPrincipalVariation(searchState, currentBestMove, result.principalVariation);
+
+    // Iterative deepening one ply at a time
+    int previousValue = 0;
+    for (int depth = 1; depth <= limits.maxDepth; depth++) {
+        mainThreadDepth = depth;
+
+        // Search with a narrow window around the value of the previous depth (a full window for the shallow depths and mates)
+        int windowSize = ASPIRATION_WINDOW_SIZE;
+        int alpha = -INFINITE_EVALUATION_VALUE;
+        int beta = INFINITE_EVALUATION_VALUE;
+        if (depth >= MIN_ASPIRATION_WINDOW_DEPTH && std::abs(previousValue) < CHECKMATE_THRESHOLD) {
+            alpha = previousValue - windowSize;
+            beta = previousValue + windowSize;
+        }
+
+        int bestMoveIndex;
+        int bestValue;
+        while (true) {
+            bestValue = searchRoot(searchState, undoStack, moves, depth, alpha, beta, bestMoveIndex);
+            if (stopSearch) {
                 break;
             }
-        } else {
-            std::cout << "Depth " << depth << " exceeded time limit. Using best move from depth " 
-                      << ((depth == 1) ? 1 : depth - 2) << std::endl;
+
+            // If the value is outside the window, widen the bound it failed on and search again.
+            // The move that failed high is better than the earlier best move, so it is searched first and kept
+            // even if the search is stopped before the value is resolved
+            if (bestValue <= alpha) {
+                alpha = std::max(bestValue - windowSize, -INFINITE_EVALUATION_VALUE);
+            }
+            else if (bestValue >= beta) {
+                beta = std::min(bestValue + windowSize, INFINITE_EVALUATION_VALUE);
+                currentBestMove = moves[bestMoveIndex];
+                orderRootMoves(moves, currentBestMove);
+            }
+            else {
+                break;
+            }
+            windowSize *= 2;
+        }
+
+        // Use the result of the depth only if the depth was completed
+        if (stopSearch) {
+            break;
+        }
+        currentBestMove = moves[bestMoveIndex];
+        previousValue = bestValue;
+
+        // Order the moves for the next depth
+        orderRootMoves(moves, currentBestMove);
+
+        // Save the result of the completed depth
+        result.bestMove = currentBestMove;
+        result.score = bestValue;
+        result.depth = depth;
+        collectPrincipalVariation(searchState, currentBestMove, result.principalVariation);
+
+        // Report the progress
+        if (limits.infoCallback) {
+            SearchInfo info;
+            info.depth = depth;
+            info.score = bestValue;
+            info.nodes = searchedNodes();
+            info.time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - searchStartTime).count();
+            info.hashfull = transpositionTable.hashfull();
+            info.bestMove = currentBestMove;
+            info.principalVariation = result.principalVariation;
+
+            // The checkmate value tells how many plies from the root the mate is
+            if (bestValue > CHECKMATE_THRESHOLD || bestValue < -CHECKMATE_THRESHOLD) {
+                int matePly = CHECKMATE_VALUE - std::abs(bestValue);
+                info.mateIn = bestValue > 0 ? (matePly + 1) / 2 : -(matePly / 2);
+            }
+
+            limits.infoCallback(info);
+        }
+
+        // If we found a checkmate, no need to search deeper
+        if (bestValue > CHECKMATE_THRESHOLD || bestValue < -CHECKMATE_THRESHOLD) {
             break;
         }
     }
 
-    // Return the best move found
-    timeExceedThread.join();
-    return currentBestMove;
+    // Stop the helper threads and the timer
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopSearch = true;
+    }
+    stopCondition.notify_all();
+    notifyIdleHelpers();
+
+    // The best move changes without completing a depth if a move failed high before the search was stopped
+    if (result.bestMove != currentBestMove) {
+        result.bestMove = currentBestMove;
+        collectPrincipalVariation(searchState, currentBestMove, result.principalVariation);
+    }
+
+    return result;
 }
 
-void ChessAI::orderMoves(std::vector<GameState>& states, const Move& transpositionTableMove, bool isWhite) {
-	std::sort(states.begin(), states.end(), [isWhite, transpositionTableMove](const GameState& a, const GameState& b) {
-		if (a.lastMove() == transpositionTableMove) {
-			return true;
-		}
-		if (b.lastMove() == transpositionTableMove) {
-			return false;
-		}
+void ChessAI::collectPrincipalVariation(GameState& state, const Move& bestMove, MoveList& principalVariation) {
+    UndoRecord undoStack[MAX_SEARCH_PLY];
+    uint64_t visitedHashes[MAX_SEARCH_PLY];
+    principalVariation.clear();
 
-		return a.evaluationValue(isWhite) > b.evaluationValue(isWhite);
-    });
+    // Follow the best moves stored in the transposition table from the position after the best move
+    Move move = bestMove;
+    while (principalVariation.size() < MAX_SEARCH_PLY) {
+        visitedHashes[principalVariation.size()] = state.hash();
+        state.makeMove(move, undoStack[principalVariation.size()]);
+        principalVariation.push_back(move);
+
+        // The stored move can be missing, overwritten or from another position with the same hash
+        int evaluationValue;
+        TranspositionTableItemType itemType;
+        move = Move(0, 0, 0, 0);
+        transpositionTable.lookup(state, 0, evaluationValue, move, itemType);
+        if (move == Move(0, 0, 0, 0) || !state.isPseudoLegal(move) || !state.isLegal(move, state.legalityMasks())) {
+            break;
+        }
+
+        // Stop at a repetition, as the line would continue forever
+        bool isRepetition = false;
+        for (int i = 0; i < principalVariation.size(); i++) {
+            isRepetition = isRepetition || visitedHashes[i] == state.hash();
+        }
+        if (isRepetition) {
+            break;
+        }
+    }
+
+    // Restore the game state
+    for (int i = principalVariation.size() - 1; i >= 0; i--) {
+        state.unmakeMove(undoStack[i]);
+    }
 }
 
-void ChessAI::runMinimax(const GameState& state, int stateIndex, int depth, bool isWhite) {
-    // Stop evaluation if time is exceeded
-    if (timeExceeded) {
-        return;
+void ChessAI::searchHelperThread(const GameState& state, MoveList moves, int maxDepth) {
+    GameState rootState(state);
+    GameState searchState;
+    UndoRecord undoStack[MAX_SEARCH_PLY];
+
+    // The helper root searches deepen from the depth of the main thread, and every other helper searches one ply deeper
+    // so the helpers fill the transposition table ahead of the main thread instead of repeating its work
+    int depthOffset = searchThreadIndex % 2;
+    int completedDepth = 0;
+    orderMoves(rootState, moves, undoStack[0], Move(0, 0, 0, 0));
+
+    // Help the other threads at their split points until the search is stopped
+    while (!stopSearch) {
+        // A notification sent after the count is read (or a stop before it) wakes the thread or aborts its root search immediately
+        unsigned long long notificationCount = idleHelperNotificationCount;
+
+        SplitPoint* splitPoint = stealSplitPoint();
+        if (splitPoint) {
+            // The split point stays alive until this thread leaves it, as its owner waits for the helpers
+            searchState = splitPoint->state;
+            activeSplitPoint = splitPoint;
+            searchSplitPoint(*splitPoint, searchState, undoStack);
+            activeSplitPoint = nullptr;
+            leaveSplitPoint(*splitPoint);
+            continue;
+        }
+
+        // Search the root on its own until a split point is published if there is nothing to steal (Lazy SMP)
+        int depth = std::max(completedDepth + 1, mainThreadDepth + depthOffset);
+        if (depth <= maxDepth) {
+            helperRootSearch = true;
+            helperRootSearchNotificationCount = notificationCount;
+            int bestMoveIndex;
+            searchRoot(rootState, undoStack, moves, depth, -INFINITE_EVALUATION_VALUE, INFINITE_EVALUATION_VALUE, bestMoveIndex);
+            bool aborted = searchAborted();
+            helperRootSearch = false;
+
+            // The results reach the main thread through the transposition table, the best move only orders the next depth
+            if (!aborted) {
+                completedDepth = depth;
+                Move bestMove = moves[bestMoveIndex];
+                orderMoves(rootState, moves, undoStack[0], bestMove);
+            }
+            continue;
+        }
+
+        // Sleep until a split point is published or the search is stopped
+        std::unique_lock<std::mutex> lock(idleHelperMutex);
+        idleHelperCondition.wait(lock, [notificationCount]() { return stopSearch || idleHelperNotificationCount != notificationCount; });
+    }
+}
+
+void ChessAI::notifyIdleHelpers() {
+    {
+        std::lock_guard<std::mutex> lock(idleHelperMutex);
+        idleHelperNotificationCount++;
+    }
+    idleHelperCondition.notify_all();
+}
+
+int ChessAI::searchRoot(GameState& state, UndoRecord* undoStack, const MoveList& moves, int depth, int alpha, int beta, int& bestMoveIndex) {
+    int bestValue = -INFINITE_EVALUATION_VALUE;
+    Move bestMove = moves[0];
+    bestMoveIndex = 0;
+
+    // The node counts of the root moves order the moves of the main thread, so the helper root searches don't record them
+    if (!helperRootSearch) {
+        for (int i = 0; i < moves.size(); i++) {
+            rootMoveNodes[i] = 0;
+        }
+    }
+
+    for (int i = 0; i < moves.size(); i++) {
+        // Stop evaluation if time is exceeded (or a helper root search gives way to a split point)
+        if (searchAborted()) {
+            break;
+        }
+
+        // Let the helper threads search the remaining moves together with this thread once the first move has been searched
+        if (i > 0 && canSplit(depth)) {
+            split(state, undoStack, moves, state.legalityMasks(), i, i, 0, depth, alpha, beta, bestValue, bestMove, nullptr, 0);
+            break;
+        }
+
+        // Evaluate the game tree branch of the move with principal variation search: the first move is searched with
+        // the full window, and the other moves with a null window at the best value so far, which is enough to prove
+        // that they are not better. Only the moves that turn out better are searched again with the full window
+        unsigned long long nodesBefore = nodeCounters[searchThreadIndex].nodes;
+        state.makeMove(moves[i], undoStack[0]);
+        int value;
+        if (i == 0) {
+            value = -negamax(state, undoStack + 1, 1, depth - 1, -beta, -alpha);
+        }
+        else {
+            value = -negamax(state, undoStack + 1, 1, depth - 1, -alpha - 1, -alpha);
+            if (value > alpha && value < beta) {
+                value = -negamax(state, undoStack + 1, 1, depth - 1, -beta, -alpha);
+            }
+        }
+        state.unmakeMove(undoStack[0]);
+        if (!helperRootSearch) {
+            rootMoveNodes[i] += nodeCounters[searchThreadIndex].nodes - nodesBefore;
+        }
+
+        // If the evaluation value is better than the previous one, update the best value
+        alpha = std::max(alpha, value);
+        if (value > bestValue) {
+            bestValue = value;
+            bestMove = moves[i];
+        }
+
+        // The value is above the window, so the window must be widened before the other moves are worth searching
+        if (alpha >= beta) {
+            break;
+        }
+    }
+
+    // Find the index of the best move
+    for (int i = 0; i < moves.size(); i++) {
+        if (moves[i] == bestMove) {
+            bestMoveIndex = i;
+            break;
+        }
+    }
+
+    return bestValue;
+}
+
+bool ChessAI::searchAborted() {
+    if (stopSearch) {
+        return true;
     }
-    
-    // Calculate the evaluation value of the game tree branch this function evaluates
-    int value = minimax(state, depth, false, isWhite);
 
-    // If the evaluation value is better than the previous one, update the best value
-    if (value > bestValue || bestValueGameStateIndex == -1) {
-        bestValue = value;
-        bestValueGameStateIndex = stateIndex;
+    // The search is aborted if any split point the thread is searching under got a cutoff
+    for (const SplitPoint* splitPoint = activeSplitPoint; splitPoint; splitPoint = splitPoint->parent) {
+        if (splitPoint->cutoff) {
+            return true;
+        }
     }
+
+    // A helper root search gives way to the split points, as helping at them is more useful
+    return helperRootSearch && idleHelperNotificationCount.load(std::memory_order_relaxed) != helperRootSearchNotificationCount;
 }
 
-int ChessAI::minimax(const GameState& state, int depth, bool isMaximizingPlayer, bool playerIsWhite, int alpha, int beta) {
-    // Check if time is exceeded
-    if (timeExceeded) {
+bool ChessAI::canSplit(int depth) {
+    return depth >= MIN_SPLIT_DEPTH && threadPool.size() > 1 && !helperRootSearch;
+}
+
+void ChessAI::split(GameState& state, UndoRecord* undoStack, const MoveList& moves, const LegalityMasks& legalityMasks, int firstMoveIndex, int searchedMoveCount, int ply, int depth, int& alpha, int beta, int& bestEval, Move& bestMove, const Move* searchedQuietMoves, int searchedQuietMoveCount) {
+    // Create the split point of the remaining moves
+    SplitPoint splitPoint(state, moves, legalityMasks);
+    splitPoint.nextMoveIndex = firstMoveIndex;
+    splitPoint.ply = ply;
+    splitPoint.depth = depth;
+    splitPoint.isCheck = state.isCheck(state.isWhiteSideToMove());
+    splitPoint.searchedMoveCount = searchedMoveCount;
+    splitPoint.alpha = alpha;
+    splitPoint.beta = beta;
+    splitPoint.bestEval = bestEval;
+    splitPoint.bestMove = bestMove;
+    splitPoint.parent = activeSplitPoint;
+    for (int i = 0; i < searchedQuietMoveCount; i++) {
+        splitPoint.searchedQuietMoves[i] = searchedQuietMoves[i];
+    }
+    splitPoint.searchedQuietMoveCount = searchedQuietMoveCount;
+
+    // Publish the split point to the queue of this thread so the idle threads can steal the remaining moves
+    SplitPointQueue& queue = splitPointQueues[searchThreadIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.splitPoints.push_back(&splitPoint);
+    }
+    notifyIdleHelpers();
+
+    // Wake the owners of the split points above this one, as they may be waiting for this thread and can help it
+    for (const SplitPoint* ancestor = splitPoint.parent; ancestor; ancestor = ancestor->parent) {
+        std::lock_guard<std::mutex> lock(ancestor->mutex);
+        ancestor->childSplitPointCount++;
+        ancestor->helperCondition.notify_one();
+    }
+
+    // Search the remaining moves together with the helpers
+    activeSplitPoint = &splitPoint;
+    searchSplitPoint(splitPoint, state, undoStack);
+    activeSplitPoint = splitPoint.parent;
+
+    // Unpublish the split point (the split points published in the searches of the moves are already removed)
+    // and wait for the helpers that are still searching its moves
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.splitPoints.pop_back();
+    }
+
+    // While waiting, help the helpers at the split points they created under this split point. Their moves
+    // are part of the result this thread waits for, and the split points stay alive as this thread is one of their helpers
+    while (true) {
+        unsigned long long childSplitPointCount;
+        {
+            std::lock_guard<std::mutex> lock(splitPoint.mutex);
+            if (splitPoint.helpers == 0) {
+                break;
+            }
+            childSplitPointCount = splitPoint.childSplitPointCount;
+        }
+
+        // Sleep until the last helper leaves or a helper publishes a new split point if there is nothing to help with
+        SplitPoint* childSplitPoint = stealSplitPoint(&splitPoint);
+        if (!childSplitPoint) {
+            std::unique_lock<std::mutex> lock(splitPoint.mutex);
+            splitPoint.helperCondition.wait(lock, [&splitPoint, childSplitPointCount]() {
+                return splitPoint.helpers == 0 || splitPoint.childSplitPointCount != childSplitPointCount;
+            });
+            continue;
+        }
+
+        // The game state of this split point is still needed by the caller, so the moves are searched on a copy
+        GameState helperState(childSplitPoint->state);
+        activeSplitPoint = childSplitPoint;
+        searchSplitPoint(*childSplitPoint, helperState, undoStack);
+        activeSplitPoint = splitPoint.parent;
+        leaveSplitPoint(*childSplitPoint);
+    }
+
+    alpha = splitPoint.alpha;
+    bestEval = splitPoint.bestEval;
+    bestMove = splitPoint.bestMove;
+}
+
+void ChessAI::searchSplitPoint(SplitPoint& splitPoint, GameState& state, UndoRecord* undoStack) {
+    while (!searchAborted()) {
+        // Take the next unsearched move of the split point
+        int moveIndex = splitPoint.nextMoveIndex++;
+        if (moveIndex >= splitPoint.moves.size()) {
+            break;
+        }
+        const Move& move = splitPoint.moves[moveIndex];
+        if (!state.isLegal(move, splitPoint.legalityMasks)) {
+            continue;
+        }
+
+        int alpha, beta;
+        {
+            std::lock_guard<std::mutex> lock(splitPoint.mutex);
+            alpha = splitPoint.alpha;
+            beta = splitPoint.beta;
+        }
+
+        // Search the eval with principal variation search using the latest bounds of the split point
+        unsigned long long nodesBefore = nodeCounters[searchThreadIndex].nodes;
+        state.makeMove(move, *undoStack);
+        // The late moves are searched with reduced depth first (except at the root) and again with full depth if they raise alpha
+        int moveNumber = ++splitPoint.searchedMoveCount;
+        int reduction = splitPoint.ply > 0 ? lateMoveReduction(state, move, splitPoint.isCheck, splitPoint.depth, moveNumber) : 0;
+        int eval = -negamax(state, undoStack + 1, splitPoint.ply + 1, splitPoint.depth - 1 - reduction, -alpha - 1, -alpha);
+        if (eval > alpha && reduction > 0) {
+            eval = -negamax(state, undoStack + 1, splitPoint.ply + 1, splitPoint.depth - 1, -alpha - 1, -alpha);
+        }
+        if (eval > alpha && eval < beta) {
+            eval = -negamax(state, undoStack + 1, splitPoint.ply + 1, splitPoint.depth - 1, -beta, -alpha);
+        }
+        state.unmakeMove(*undoStack);
+        if (splitPoint.ply == 0) {
+            rootMoveNodes[moveIndex] += nodeCounters[searchThreadIndex].nodes - nodesBefore;
+        }
+
+        // The value of an aborted search is not reliable
+        if (searchAborted()) {
+            break;
+        }
+
+        // Update the bounds and the best move of the split point
+        std::lock_guard<std::mutex> lock(splitPoint.mutex);
+        splitPoint.alpha = std::max(splitPoint.alpha, eval);
+        if (eval > splitPoint.bestEval) {
+            splitPoint.bestEval = eval;
+            splitPoint.bestMove = move;
+        }
+
+        // Alpha-beta pruning (stops the other threads searching the moves of the split point). The quiet moves
+        // searched by all threads before the cutoff are penalized the same way as in a node that is not split
+        if (splitPoint.beta <= splitPoint.alpha) {
+            splitPoint.cutoff = true;
+            if (!move.isCapture()) {
+                searchHistories[searchThreadIndex].updateCutoff(state, move, splitPoint.ply, splitPoint.depth, splitPoint.searchedQuietMoves, splitPoint.searchedQuietMoveCount);
+            }
+            break;
+        }
+        if (!move.isCapture() && splitPoint.searchedQuietMoveCount < MAX_PENALIZED_QUIET_MOVES) {
+            splitPoint.searchedQuietMoves[splitPoint.searchedQuietMoveCount++] = move;
+        }
+    }
+}
+
+SplitPoint* ChessAI::stealSplitPoint(const SplitPoint* ancestor) {
+    // The parents of a published split point stay alive while it is in its queue, as their threads wait for its owner
+    auto isUnder = [ancestor](const SplitPoint* splitPoint) {
+        for (const SplitPoint* parent = splitPoint->parent; parent; parent = parent->parent) {
+            if (parent == ancestor) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Look through the queues of the other threads, starting from the oldest (shallowest) split points that have the most work left
+    for (int i = 1; i < threadPool.size(); i++) {
+        SplitPointQueue& queue = splitPointQueues[(searchThreadIndex + i) % threadPool.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (SplitPoint* splitPoint : queue.splitPoints) {
+            if (!splitPoint->cutoff && splitPoint->nextMoveIndex < splitPoint->moves.size() && (!ancestor || isUnder(splitPoint))) {
+                // Join while the queue is locked, so the owner can't remove the split point before it waits for the helpers
+                splitPoint->helpers++;
+                return splitPoint;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void ChessAI::leaveSplitPoint(SplitPoint& splitPoint) {
+    // The owner may return and destroy the split point as soon as the mutex is released, so it is notified while the mutex is locked
+    std::lock_guard<std::mutex> lock(splitPoint.mutex);
+    if (--splitPoint.helpers == 0) {
+        splitPoint.helperCondition.notify_one();
+    }
+}
+
+void ChessAI::orderRootMoves(MoveList& moves, const Move& bestMove) {
+    // Score every move by the node count of its subtree (the best move first), keeping the order of equal moves
+    for (int i = 0; i < moves.size(); i++) {
+        if (moves[i] == bestMove) {
+            moves.setScore(i, std::numeric_limits<int>::max());
+            continue;
+        }
+
+        unsigned long long nodes = rootMoveNodes[i];
+        moves.setScore(i, static_cast<int>(std::min<unsigned long long>(nodes, std::numeric_limits<int>::max() - 1)));
+    }
+
+    moves.sortByScore();
+}
+
+void ChessAI::orderMoves(GameState& state, MoveList& moves, UndoRecord& undo, const Move& transpositionTableMove) {
+    // Score every move by the evaluation value of the game state it leads to (the transposition table move first)
+    for (int i = 0; i < moves.size(); i++) {
+        if (moves[i] == transpositionTableMove) {
+            moves.setScore(i, std::numeric_limits<int>::max());
+            continue;
+        }
+
+        state.makeMove(moves[i], undo);
+        moves.setScore(i, -state.evaluationValue(state.isWhiteSideToMove()));
+        state.unmakeMove(undo);
+    }
+
+    moves.sortByScore();
+}
+
+int ChessAI::negamax(GameState& state, UndoRecord* undoStack, int ply, int depth, int alpha, int beta) {
+    // Check if time is exceeded or a sibling of a split point above this node produced a cutoff
+    if (searchAborted()) {
         // Return a neutral value that won't affect the search
         return 0;
     }
+    countNode();
     
     // The alpha and beta before the changes made to them in this function
     int alphaOrig = alpha;
@@ -128,8 +810,10 @@ int ChessAI::minimax(const GameState& state, int depth, bool isMaximizingPlayer,
     int transpositionTableEvaluationValue;
 	Move transpositionTableMove = Move(0, 0, 0, 0);
     TranspositionTableItemType transpositionTableItemType;
-    if (transpositionTable.lookup(state, depth, playerIsWhite, transpositionTableEvaluationValue, transpositionTableMove, transpositionTableItemType)) {
-        // If the stored value is exact minimax value, return it
+    if (transpositionTable.lookup(state, depth, transpositionTableEvaluationValue, transpositionTableMove, transpositionTableItemType)) {
+        transpositionTableEvaluationValue = valueFromTranspositionTable(transpositionTableEvaluationValue, ply);
+
+        // If the stored value is exact negamax value, return it
         if (transpositionTableItemType == TranspositionTableItemType::Exact) {
             return transpositionTableEvaluationValue;
         }
@@ -150,121 +834,122 @@ int ChessAI::minimax(const GameState& state, int depth, bool isMaximizingPlayer,
     
     // If we've reached the maximum depth or game is over
     if (depth == 0) {
-        return quiescenceSearch(state, playerIsWhite, alpha, beta);
-    }
-
-    // Fetch the possible new game states that can be made from the current evaluation game state with one move
-    std::vector<GameState> possibleStates;
-    state.possibleNewGameStates(possibleStates);
-
-    // If no moves are available, this is checkmate or stalemate
-    if (possibleStates.empty()) {
-        if (state.isCheck(isMaximizingPlayer ? playerIsWhite : !playerIsWhite)) {
-            return isMaximizingPlayer ? -1000000 - (depth * 10000) : 1000000 + (depth * 10000);
-        }
-        return 0; // Stalemate
+        return quiescenceSearch(state, undoStack, alpha, beta);
     }
 
     // Make null move reductions search if the player is not in check and the depth is sufficient
-    if (!state.isCheck(isMaximizingPlayer ? playerIsWhite : !playerIsWhite) && depth >= NULL_MOVE_SEARCH_REDUCTION + 1) {
-        // Create a game state copy and apply a null move to it
-        GameState nullMoveState(state);
-        nullMoveState.applyNullMove();
-
-        // Evaluate the null move game state with reduced depth
-        int eval = minimax(nullMoveState, depth - 1 - NULL_MOVE_SEARCH_REDUCTION, !isMaximizingPlayer, playerIsWhite, alpha, beta);
+    bool isCheck = state.isCheck(state.isWhiteSideToMove());
+    if (!isCheck && depth >= NULL_MOVE_SEARCH_REDUCTION + 1) {
+        // Make a null move and evaluate the game state with reduced depth
+        state.makeNullMove(*undoStack);
+        int eval = -negamax(state, undoStack + 1, ply + 1, depth - 1 - NULL_MOVE_SEARCH_REDUCTION, -beta, -alpha);
+        state.unmakeNullMove(*undoStack);
         
-        // If the evaluation produces a alpha/beta cutoff, decrease search depth
+        // If the evaluation produces a beta cutoff, decrease search depth
         // or do quiescence search if the depth becomes too shallow
-        if ((isMaximizingPlayer && eval >= beta) || (!isMaximizingPlayer && eval <= alpha)) {
+        if (eval >= beta) {
             depth -= 4;
             if (depth <= 0) {
-                return quiescenceSearch(state, playerIsWhite, alpha, beta);
+                return quiescenceSearch(state, undoStack, alpha, beta);
             }
         }
     }
 
-    // Order moves before evaluation
-    orderMoves(possibleStates, transpositionTableMove, isMaximizingPlayer ? playerIsWhite : !playerIsWhite);
+    // Pick the pseudo-legal moves in the search order lazily, and check their legality only when they are about to be searched
+    SearchHistory& history = searchHistories[searchThreadIndex];
+    MovePicker movePicker(state, transpositionTableMove, history, ply);
+    LegalityMasks legalityMasks = state.legalityMasks();
+    Move move = Move(0, 0, 0, 0);
+
+    // The quiet moves searched without a cutoff, whose history scores are reduced if a later quiet move gets a cutoff
+    Move searchedQuietMoves[MAX_PENALIZED_QUIET_MOVES];
+    int searchedQuietMoveCount = 0;
 
-    // The best evaluation value and move found for the game state
-    int bestEval;
+    // The best evaluation value and move found for the game state, and the amount of legal moves searched
+    int bestEval = -INFINITE_EVALUATION_VALUE;
 	Move bestMove = Move(0, 0, 0, 0);
+    int legalMoveCount = 0;
 
-    // Handle the maximizer's turn
-    if (isMaximizingPlayer) {
-        bestEval = std::numeric_limits<int>::min();
-        bool firstMove = true;
-        for (const auto& newState : possibleStates) {
-            // Check time limit before recursing
-            if (timeExceeded) {
-                return 0;
-            }
+    while (movePicker.next(move)) {
+        // Check time limit before recursing
+        if (searchAborted()) {
+            return 0;
+        }
 
-            // Search the eval with principal variation search
-            int eval;
-            if (firstMove) {
-                eval = minimax(newState, depth - 1, false, playerIsWhite, alpha, beta);
-                firstMove = false;
-            } else {
-                eval = minimax(newState, depth - 1, false, playerIsWhite, alpha, alpha + 1);
-                if (eval > alpha && eval < beta) {
-                    eval = minimax(newState, depth - 1, false, playerIsWhite, alpha, beta);
-                }
-            }
+        // Late move pruning: at shallow depth the late quiet moves are unlikely to raise alpha, so they are not searched.
+        // A legal move has been searched before, so the node can't be mistaken for a checkmate or stalemate
+        if (!isCheck && depth <= LATE_MOVE_PRUNING_MAX_DEPTH && legalMoveCount >= LATE_MOVE_PRUNING_MOVE_COUNT + depth * depth
+            && !move.isCapture() && !move.isPromotion() && bestEval > -CHECKMATE_THRESHOLD) {
+            movePicker.skipQuiets();
+            continue;
+        }
 
-            alpha = std::max(alpha, eval);
-			if (eval > bestEval) {
-				bestEval = eval;
-				bestMove = newState.lastMove();
-			}
-            
-            // Alpha-beta pruning
-            if (beta <= alpha) {
-                break;
-            }
+        // Skip the illegal moves
+        if (!state.isLegal(move, legalityMasks)) {
+            continue;
         }
-    // Handle the minimizer's turn
-    } else {
-        bestEval = std::numeric_limits<int>::max();
-        bool firstMove = true;
-        for (const auto& newState : possibleStates) {
-            // Check time limit before recursing
-            if (timeExceeded) {
-                return 0;
-            }
-            
-            // Search the eval with principal variation search
-            int eval;
-            if (firstMove) {
-                eval = minimax(newState, depth - 1, true, playerIsWhite, alpha, beta);
-                firstMove = false;
-            }
-            else {
-                eval = minimax(newState, depth - 1, true, playerIsWhite, beta - 1, beta);
-                if (eval < beta && eval > alpha) {
-                    eval = minimax(newState, depth - 1, true, playerIsWhite, alpha, beta);
-                }
-            }
 
-            beta = std::min(beta, eval);
-            if (eval < bestEval) {
-                bestEval = eval;
-                bestMove = newState.lastMove();
+        // Let idle search threads help with the remaining moves once the first legal move has been searched.
+        // The moves are collected on the heap, as a move list in every frame would use the thread stacks up quickly
+        if (legalMoveCount > 0 && canSplit(depth)) {
+            std::unique_ptr<MoveList> remainingMoves(new MoveList());
+            do {
+                remainingMoves->push_back(move);
+            } while (movePicker.next(move));
+            split(state, undoStack, *remainingMoves, legalityMasks, 0, legalMoveCount, ply, depth, alpha, beta, bestEval, bestMove, searchedQuietMoves, searchedQuietMoveCount);
+            break;
+        }
+
+        // Search the eval with principal variation search: the moves after the first one are expected to fail low,
+        // which is verified with a null window search, and only the moves that don't are searched with the full window.
+        // The late moves are verified with reduced depth first and again with full depth if they raise alpha
+        state.makeMove(move, *undoStack);
+        int eval;
+        if (legalMoveCount++ == 0) {
+            eval = -negamax(state, undoStack + 1, ply + 1, depth - 1, -beta, -alpha);
+        } else {
+            int reduction = lateMoveReduction(state, move, isCheck, depth, legalMoveCount);
+            eval = -negamax(state, undoStack + 1, ply + 1, depth - 1 - reduction, -alpha - 1, -alpha);
+            if (eval > alpha && reduction > 0) {
+                eval = -negamax(state, undoStack + 1, ply + 1, depth - 1, -alpha - 1, -alpha);
+            }
+            if (eval > alpha && eval < beta) {
+                eval = -negamax(state, undoStack + 1, ply + 1, depth - 1, -beta, -alpha);
             }
+        }
+        state.unmakeMove(*undoStack);
 
-            // Alpha-beta pruning
-            if (beta <= alpha) {
-                break;
+        alpha = std::max(alpha, eval);
+		if (eval > bestEval) {
+			bestEval = eval;
+			bestMove = move;
+		}
+        
+        // Alpha-beta pruning (a quiet move that produces a cutoff orders the quiet moves of the nodes searched later)
+        if (beta <= alpha) {
+            if (!move.isCapture()) {
+                history.updateCutoff(state, move, ply, depth, searchedQuietMoves, searchedQuietMoveCount);
             }
+            break;
+        }
+        if (!move.isCapture() && searchedQuietMoveCount < MAX_PENALIZED_QUIET_MOVES) {
+            searchedQuietMoves[searchedQuietMoveCount++] = move;
         }
     }
 
-    // If time is exceeded, don't store in the transposition table
-    if (timeExceeded) {
+    // If the search was aborted, the value is not reliable, so don't store it in the transposition table
+    if (searchAborted()) {
         return bestEval;
     }
 
+    // If no legal moves are available, this is checkmate or stalemate
+    if (legalMoveCount == 0) {
+        if (isCheck) {
+            return -CHECKMATE_VALUE + ply;
+        }
+        return 0; // Stalemate
+    }
+
     // Calculate the transposition table item type of this node
     TranspositionTableItemType transpositionItemType;
     if (bestEval <= alphaOrig) {
@@ -278,20 +963,21 @@ int ChessAI::minimax(const GameState& state, int depth, bool isMaximizingPlayer,
     }
 
     // Store the result of the evaluation of this game state to the transposition table
-    transpositionTable.store(state, bestEval, depth, playerIsWhite, transpositionItemType, bestMove);
+    transpositionTable.store(state, valueToTranspositionTable(bestEval, ply), depth, transpositionItemType, bestMove);
 
     // Return the evaluation value of this game state
     return bestEval;
 }
 
-int ChessAI::quiescenceSearch(const GameState& state, bool playerIsWhite, int alpha, int beta, int depth) {
-    // Check if time is exceeded
-    if (timeExceeded) {
+int ChessAI::quiescenceSearch(GameState& state, UndoRecord* undoStack, int alpha, int beta, int depth) {
+    // Check if time is exceeded or a sibling of a split point above this node produced a cutoff
+    if (searchAborted()) {
         return 0;
     }
+    countNode();
     
     // Base evaluation
-    int standPat = state.evaluationValue(playerIsWhite);
+    int standPat = state.evaluationValue(state.isWhiteSideToMove());
     
     // Return if maximum depth or checkmate
     if (depth == 0) {
@@ -308,21 +994,25 @@ int ChessAI::quiescenceSearch(const GameState& state, bool playerIsWhite, int al
         alpha = standPat;
     }
 
-    // Get capturing moves only
-    std::vector<GameState> capturingStates;
-    state.possibleNewGameStates(capturingStates, true);
-
-    // Order moves for better pruning
-    orderMoves(capturingStates, Move(0, 0, 0, 0), playerIsWhite);
+    // Pick capturing moves only in MVV-LVA order, pruning the captures that lose material by static exchange evaluation
+    // (their legality is checked when they are about to be searched)
+    MovePicker movePicker(state);
+    LegalityMasks legalityMasks = state.legalityMasks();
 
     // Search capturing moves
-    for (const auto& newState : capturingStates) {
+    Move move = Move(0, 0, 0, 0);
+    while (movePicker.next(move)) {
         // Check time limit
-        if (timeExceeded) {
+        if (searchAborted()) {
             return alpha;
         }
+        if (!state.isLegal(move, legalityMasks)) {
+            continue;
+        }
         
-        int score = -quiescenceSearch(newState, !playerIsWhite, -beta, -alpha, depth - 1);
+        state.makeMove(move, *undoStack);
+        int score = -quiescenceSearch(state, undoStack + 1, -beta, -alpha, depth - 1);
+        state.unmakeMove(*undoStack);
         
         if (score >= beta) {
             return beta;
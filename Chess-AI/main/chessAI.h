@@ -4,91 +4,874 @@
 #include <mutex>
 #include <atomic>
 #include <chrono>
+#include <limits>
+#include <memory>
+#include <deque>
+#include <thread>
+#include <functional>
+#include <condition_variable>
 #include "gameState/gameState.h"
 #include "move.h"
+#include "moveList.h"
 #include "transpositionTable.h"
+#include "threadPool.h"
 
 /// <summary>
 /// The amount null move search is shallower than the normal search in the node.
 /// </summary>
 constexpr auto NULL_MOVE_SEARCH_REDUCTION = 2;
 
+/// <summary>
+/// The minimum remaining depth of a node whose late quiet moves are searched with reduced depth.
+/// </summary>
+constexpr auto LATE_MOVE_REDUCTION_MIN_DEPTH = 3;
+
+/// <summary>
+/// The move number (counted from 1 in the search order) of the first move of a node that can be searched with reduced depth.
+/// </summary>
+constexpr auto LATE_MOVE_REDUCTION_MIN_MOVE_NUMBER = 4;
+
+/// <summary>
+/// The constant part of the late move reduction. The reduction is
+/// LATE_MOVE_REDUCTION_BASE + ln(depth) * ln(move number) / LATE_MOVE_REDUCTION_DIVISOR rounded down.
+/// </summary>
+constexpr auto LATE_MOVE_REDUCTION_BASE = 0.75;
+
+/// <summary>
+/// The divisor of the depth and move number dependent part of the late move reduction.
+/// </summary>
+constexpr auto LATE_MOVE_REDUCTION_DIVISOR = 2.25;
+
+/// <summary>
+/// The maximum remaining depth of a node whose late quiet moves are pruned.
+/// </summary>
+constexpr auto LATE_MOVE_PRUNING_MAX_DEPTH = 3;
+
+/// <summary>
+/// The amount of legal moves a node with remaining depth 1 searches before its quiet moves are pruned.
+/// The amount grows with the square of the depth.
+/// </summary>
+constexpr auto LATE_MOVE_PRUNING_MOVE_COUNT = 3;
+
+/// <summary>
+/// The maximum amount of moves a search thread can make on top of the searched game state.
+/// This is the size of the undo record stack of every search thread.
+/// </summary>
+constexpr auto MAX_SEARCH_PLY = 128;
+
+/// <summary>
+/// The half width of the aspiration window around the value of the previous iterative deepening depth.
+/// The window is doubled every time the value falls outside it.
+/// </summary>
+constexpr auto ASPIRATION_WINDOW_SIZE = 50;
+
+/// <summary>
+/// The minimum iterative deepening depth searched with an aspiration window. The shallower depths are searched
+/// with the full window, as their values are too unstable to predict the next value.
+/// </summary>
+constexpr auto MIN_ASPIRATION_WINDOW_DEPTH = 4;
+
+/// <summary>
+/// The maximum depth of the quiescence search.
+/// </summary>
+constexpr auto QUIESCENCE_SEARCH_DEPTH = 4;
+
+/// <summary>
+/// The transposition table size in megabytes that is used if the size is not set with setTranspositionTableSize.
+/// </summary>
+constexpr auto DEFAULT_TRANSPOSITION_TABLE_SIZE = 256;
+
+/// <summary>
+/// The minimum remaining depth of a node whose moves can be searched in parallel.
+/// Shallower nodes are searched by one thread as their subtrees are too small to share.
+/// </summary>
+constexpr auto MIN_SPLIT_DEPTH = 4;
+
+/// <summary>
+/// A value greater than any evaluation value, used as the bounds of a full search window.
+/// The value can be negated without overflow, unlike the limits of int.
+/// </summary>
+constexpr auto INFINITE_EVALUATION_VALUE = 100000000;
+
+/// <summary>
+/// The evaluation value of a checkmate. The side to move that is checkmated at ply p from the root gets
+/// the value -(CHECKMATE_VALUE - p), so faster mates have higher absolute values.
+/// </summary>
+constexpr auto CHECKMATE_VALUE = 1000000;
+
+/// <summary>
+/// Evaluation values with higher absolute value than this are checkmates.
+/// </summary>
+constexpr auto CHECKMATE_THRESHOLD = CHECKMATE_VALUE - MAX_SEARCH_PLY;
+
+/// <summary>
+/// The amount of killer moves stored for every ply.
+/// </summary>
+constexpr auto KILLER_MOVE_COUNT = 2;
+
+/// <summary>
+/// The maximum absolute value of a history score. The scores are updated with a gravity that keeps them within the limit.
+/// </summary>
+constexpr auto MAX_HISTORY_SCORE = 16384;
+
+/// <summary>
+/// The maximum amount of searched quiet moves of a node whose history scores are reduced when a later quiet move gets a cutoff.
+/// </summary>
+constexpr auto MAX_PENALIZED_QUIET_MOVES = 64;
+
+/// <summary>
+/// Information about the progress of a best move search, reported after every completed iterative deepening depth.
+/// </summary>
+struct SearchInfo {
+    /// <summary>
+    /// The completed search depth.
+    /// </summary>
+    int depth = 0;
+
+    /// <summary>
+    /// The evaluation value of the best move from the perspective of the side to move.
+    /// </summary>
+    int score = 0;
+
+    /// <summary>
+    /// The amount of moves to the found checkmate (negative if the side to move gets mated), or 0 if no checkmate was found.
+    /// </summary>
+    int mateIn = 0;
+
+    /// <summary>
+    /// The amount of nodes searched by all threads.
+    /// </summary>
+    unsigned long long nodes = 0;
+
+    /// <summary>
+    /// The time since the start of the search in milliseconds.
+    /// </summary>
+    long long time = 0;
+
+    /// <summary>
+    /// How full the transposition table is per mille.
+    /// </summary>
+    int hashfull = 0;
+
+    /// <summary>
+    /// The best move found.
+    /// </summary>
+    Move bestMove = Move(0, 0, 0, 0);
+
+    /// <summary>
+    /// The principal variation: the best move and the expected best moves of both sides after it.
+    /// </summary>
+    MoveList principalVariation;
+};
+
+/// <summary>
+/// The result of a best move search: the best move and principal variation of the deepest completed depth.
+/// </summary>
+struct SearchResult {
+    /// <summary>
+    /// The best move, or Move(0, 0, 0, 0) if there are no legal moves.
+    /// </summary>
+    Move bestMove = Move(0, 0, 0, 0);
+
+    /// <summary>
+    /// The principal variation starting with the best move. The line is reconstructed from the best moves stored
+    /// in the transposition table, so it can be shorter than the search depth if the items have been replaced.
+    /// </summary>
+    MoveList principalVariation;
+
+    /// <summary>
+    /// The evaluation value of the best move from the perspective of the side to move.
+    /// </summary>
+    int score = 0;
+
+    /// <summary>
+    /// The deepest completed search depth, or 0 if no depth was completed.
+    /// </summary>
+    int depth = 0;
+};
+
+/// <summary>
+/// Describes when a best move search stops and where its progress is reported.
+/// </summary>
+struct SearchLimits {
+    /// <summary>
+    /// The maximum Negamax evaluation depth.
+    /// </summary>
+    int maxDepth = MAX_SEARCH_PLY - QUIESCENCE_SEARCH_DEPTH - 1;
+
+    /// <summary>
+    /// The time limit in milliseconds, or 0 for no time limit.
+    /// When pondering, the time limit starts when the ponder move is played.
+    /// </summary>
+    int timeLimit = 0;
+
+    /// <summary>
+    /// If the search should not return before it is stopped, even if it reaches the maximum depth.
+    /// </summary>
+    bool infinite = false;
+
+    /// <summary>
+    /// If the search is a ponder search. The search runs without time limit and doesn't return before
+    /// it is stopped or the ponder move is played.
+    /// </summary>
+    bool ponder = false;
+
+    /// <summary>
+    /// Function called with the progress of the search after every completed depth, or empty if not needed.
+    /// The function is called from the main search thread.
+    /// </summary>
+    std::function<void(const SearchInfo&)> infoCallback;
+};
+
+/// <summary>
+/// A search node counter of one search thread. The counters are padded to the size of a cache line,
+/// so the threads don't slow each other down by writing to the same cache line.
+/// </summary>
+struct NodeCounter {
+    /// <summary>
+    /// The amount of nodes searched by the thread. Only written by its own thread.
+    /// </summary>
+    std::atomic<unsigned long long> nodes{ 0 };
+
+    /// <summary>
+    /// Padding that fills the rest of the cache line.
+    /// </summary>
+    char padding[64 - sizeof(std::atomic<unsigned long long>)];
+};
+
+/// <summary>
+/// The quiet moves that have produced beta cutoffs in the search of one search thread, used to order the quiet moves.
+/// Every thread has its own tables, so the threads don't need to synchronize when updating them.
+/// </summary>
+struct SearchHistory {
+    /// <summary>
+    /// The latest quiet moves that produced a cutoff at every ply, newest first.
+    /// </summary>
+    Move killerMoves[MAX_SEARCH_PLY][KILLER_MOVE_COUNT];
+
+    /// <summary>
+    /// The history scores of the quiet moves indexed with the color of the moving side (0 for white), the from square and the to square.
+    /// </summary>
+    int historyScores[2][64][64];
+
+    /// <summary>
+    /// The quiet moves that refuted the previous move, indexed with the piece index and the to square of the previous move.
+    /// </summary>
+    Move counterMoves[12][64];
+
+    /// <summary>
+    /// Removes all killer moves, history scores and counter moves.
+    /// </summary>
+    void clear();
+
+    /// <summary>
+    /// Prepares the tables for a new search by removing the killer moves and halving the history scores,
+    /// so the information of the earlier searches still orders the moves but adapts faster to the new position.
+    /// </summary>
+    void newSearch();
+
+    /// <summary>
+    /// Updates the tables with a quiet move that produced a beta cutoff. The move becomes a killer move of the ply
+    /// and the counter move of the previous move, its history score is increased and the history scores
+    /// of the quiet moves searched before it are decreased.
+    /// </summary>
+    /// <param name="state">The game state of the node (the move not made)</param>
+    /// <param name="move">The quiet move that produced the cutoff</param>
+    /// <param name="ply">The distance of the node from the root</param>
+    /// <param name="depth">The remaining depth of the node</param>
+    /// <param name="searchedQuietMoves">The quiet moves searched before the move without a cutoff</param>
+    /// <param name="searchedQuietMoveCount">The amount of the searched quiet moves</param>
+    void updateCutoff(const GameState& state, const Move& move, int ply, int depth, const Move* searchedQuietMoves, int searchedQuietMoveCount);
+
+    /// <summary>
+    /// The history score of the given quiet move.
+    /// </summary>
+    /// <param name="isWhite">If the moving side is white</param>
+    /// <param name="move">The quiet move</param>
+    /// <returns>The history score</returns>
+    int historyScore(bool isWhite, const Move& move) const {
+        return historyScores[isWhite ? 0 : 1][move.fromSquare()][move.toSquare()];
+    }
+
+    /// <summary>
+    /// The counter move of the last move of the given game state.
+    /// </summary>
+    /// <param name="state">The game state</param>
+    /// <returns>The counter move, or Move(0, 0, 0, 0) if not available</returns>
+    Move counterMove(const GameState& state) const;
+};
+
+/// <summary>
+/// Describes a node whose remaining moves are searched in parallel (Young Brothers Wait).
+/// The split point is created by the thread searching the node after the first move has been searched,
+/// and it lives on the stack of that thread until all threads have finished searching its moves.
+/// </summary>
+struct SplitPoint {
+    /// <summary>
+    /// The game state of the node. The helper threads search the moves on their own copies of it.
+    /// </summary>
+    const GameState state;
+
+    /// <summary>
+    /// The ordered pseudo-legal moves of the node.
+    /// </summary>
+    const MoveList& moves;
+
+    /// <summary>
+    /// The legality masks of the game state of the node, used to skip the illegal moves.
+    /// </summary>
+    const LegalityMasks legalityMasks;
+
+    /// <summary>
+    /// The index of the next move that has not been taken by any thread.
+    /// </summary>
+    std::atomic<int> nextMoveIndex{ 0 };
+
+    /// <summary>
+    /// The amount of helper threads searching the moves of the split point (the owner thread not included).
+    /// </summary>
+    std::atomic<int> helpers{ 0 };
+
+    /// <summary>
+    /// Flag set when a move of the split point produces an alpha-beta cutoff.
+    /// The threads searching the other moves of the split point abort their searches.
+    /// </summary>
+    std::atomic<bool> cutoff{ false };
+
+    /// <summary>
+    /// The split point the node is in, or null if the node is not searched under any split point.
+    /// </summary>
+    const SplitPoint* parent = nullptr;
+
+    /// <summary>
+    /// The distance of the node from the root.
+    /// </summary>
+    int ply = 0;
+
+    /// <summary>
+    /// The remaining search depth of the node.
+    /// </summary>
+    int depth = 0;
+
+    /// <summary>
+    /// Whether the side to move at the node is in check.
+    /// </summary>
+    bool isCheck = false;
+
+    /// <summary>
+    /// The amount of legal moves of the node taken for search, used as the move numbers of the late move reductions.
+    /// </summary>
+    std::atomic<int> searchedMoveCount{ 0 };
+
+    /// <summary>
+    /// The mutex protecting the bounds, the best move and the searched quiet moves of the split point,
+    /// and the helper count changes the owner waits for.
+    /// </summary>
+    mutable std::mutex mutex;
+
+    /// <summary>
+    /// Condition variable the owner thread waits with for its helpers to leave the split point
+    /// or to publish new split points under it. Used with the mutex.
+    /// </summary>
+    mutable std::condition_variable helperCondition;
+
+    /// <summary>
+    /// The amount of split points published under this split point, used to detect the split points published
+    /// between the owner looking for work and starting to wait. Protected by the mutex.
+    /// </summary>
+    mutable unsigned long long childSplitPointCount = 0;
+
+    /// <summary>
+    /// The alpha value of the node from the perspective of the side to move.
+    /// </summary>
+    int alpha = 0;
+
+    /// <summary>
+    /// The beta value of the node from the perspective of the side to move.
+    /// </summary>
+    int beta = 0;
+
+    /// <summary>
+    /// The best evaluation value found for the node.
+    /// </summary>
+    int bestEval = 0;
+
+    /// <summary>
+    /// The best move found for the node.
+    /// </summary>
+    Move bestMove = Move(0, 0, 0, 0);
+
+    /// <summary>
+    /// The quiet moves of the node searched without a cutoff, whose history scores are reduced if a later quiet move gets a cutoff.
+    /// </summary>
+    Move searchedQuietMoves[MAX_PENALIZED_QUIET_MOVES];
+
+    /// <summary>
+    /// The amount of the searched quiet moves.
+    /// </summary>
+    int searchedQuietMoveCount = 0;
+
+    /// <summary>
+    /// Creates a split point of the given node.
+    /// </summary>
+    /// <param name="state">The game state of the node</param>
+    /// <param name="moves">The ordered pseudo-legal moves of the node</param>
+    /// <param name="legalityMasks">The legality masks of the game state of the node</param>
+    SplitPoint(const GameState& state, const MoveList& moves, const LegalityMasks& legalityMasks) : state(state), moves(moves), legalityMasks(legalityMasks) {}
+};
+
+/// <summary>
+/// The split points a search thread has published for the other threads to help with.
+/// The newest (deepest) split point is at the back.
+/// </summary>
+struct SplitPointQueue {
+    /// <summary>
+    /// The mutex protecting the split points of the queue.
+    /// </summary>
+    std::mutex mutex;
+
+    /// <summary>
+    /// The published split points.
+    /// </summary>
+    std::deque<SplitPoint*> splitPoints;
+};
+
 class ChessAI {
 public:
     /// <summary>
-    /// Finds the best next move for the given game state using Minimax algorithm with iterative deepening.
+    /// Finds the best next move for the given game state using Negamax algorithm with iterative deepening.
+    /// The search runs on all threads of the search thread pool.
     /// </summary>
     /// <param name="state">The game state to search move for</param>
-    /// <param name="maxDepth">The maximum Minimax evaluation depth</param>
+    /// <param name="maxDepth">The maximum Negamax evaluation depth</param>
     /// <param name="timeLimit">The time limit in milliseconds (default: 4000ms)</param>
     /// <returns>The best move, or Move(0, 0, 0, 0) if no moves found</returns>
     static Move findBestMove(const GameState& state, int maxDepth, int timeLimit = 4000);
 
+    /// <summary>
+    /// Finds the best next move for the given game state with the given search limits.
+    /// </summary>
+    /// <param name="state">The game state to search move for</param>
+    /// <param name="limits">The search limits</param>
+    /// <returns>The search result, whose best move is Move(0, 0, 0, 0) if no moves found</returns>
+    static SearchResult findBestMove(const GameState& state, const SearchLimits& limits);
+
+    /// <summary>
+    /// Starts finding the best next move for the given game state in the background and returns immediately.
+    /// The search can be controlled with stop and ponderhit after this function has returned.
+    /// Waits for the earlier background search to finish first.
+    /// </summary>
+    /// <param name="state">The game state to search move for</param>
+    /// <param name="limits">The search limits</param>
+    /// <param name="onFinished">Function called with the search result from the background thread when the search has finished</param>
+    static void startSearch(const GameState& state, const SearchLimits& limits, const std::function<void(const SearchResult&)>& onFinished);
+
+    /// <summary>
+    /// Waits for the background search started with startSearch to finish. Returns immediately if there is no background search.
+    /// </summary>
+    static void waitForSearch();
+
+    /// <summary>
+    /// Stops the running search. The search returns the best move found so far.
+    /// </summary>
+    static void stop();
+
+    /// <summary>
+    /// Tells the running ponder search that the ponder move was played. The search continues as a normal search
+    /// and its time limit starts.
+    /// </summary>
+    static void ponderhit();
+
+    /// <summary>
+    /// Removes all items from the transposition table.
+    /// Must not be called while a best move search is running.
+    /// </summary>
+    static void clearTranspositionTable();
+
+    /// <summary>
+    /// Reallocates the transposition table to the given size. The table is cleared.
+    /// A smaller table is used if the memory cannot be allocated.
+    /// Must not be called while a best move search is running.
+    /// </summary>
+    /// <param name="megabytes">The size of the transposition table in megabytes</param>
+    /// <returns>The size of the transposition table in megabytes after resizing</returns>
+    static int setTranspositionTableSize(int megabytes);
+
+    /// <summary>
+    /// Sets the amount of search threads (at least 1).
+    /// Must not be called while a best move search is running.
+    /// </summary>
+    /// <param name="threadCount">The amount of search threads</param>
+    static void setThreadCount(int threadCount);
+
+    /// <summary>
+    /// Removes the killer moves, history scores and counter moves of all search threads.
+    /// Must not be called while a best move search is running.
+    /// </summary>
+    static void clearSearchHistory();
+
 private:
     /// <summary>
-    /// The currently best value found by the runMinimax function.
-    /// The value is reset when starting a new best move search.
+    /// Flag telling the search threads to stop. Set when the time limit has been exceeded
+    /// or when the main search thread has finished.
     /// </summary>
-    static std::atomic<int> bestValue;
+    static std::atomic<bool> stopSearch;
 
     /// <summary>
-    /// The index of the game state with the currently best value found by the runMinimax function.
-    /// The value is reset when starting a new best move search.
+    /// The mutex the time limit thread waits for the search to stop with.
     /// </summary>
-    static std::atomic<int> bestValueGameStateIndex;
-    
+    static std::mutex stopMutex;
+
     /// <summary>
-    /// Flag indicating whether the time limit has been exceeded.
+    /// Condition variable notified when the search is stopped before the time limit or the ponder move is played.
     /// </summary>
-    static std::atomic<bool> timeExceeded;
+    static std::condition_variable stopCondition;
 
     /// <summary>
-    /// The transposition table.
+    /// Flag telling that the search was stopped with stop. Protected by stopMutex.
     /// </summary>
-    static TranspositionTable<30000000> transpositionTable;
+    static bool stopRequested;
 
     /// <summary>
-    /// Thread safe function that evaluates the given GameState with the minimax function.
-    /// If the minimax result is greater than the value of bestValue, sets the result as the value
-    /// of bestValue and the stateIndex as the value of bestValueGameStateIndex.
+    /// Flag telling that the running search is pondering. Protected by stopMutex.
     /// </summary>
-    /// <param name="state">The game state this function should evaluate with Minimax</param>
-    /// <param name="stateIndex">The index of the given state</param>
+    static bool pondering;
+
+    /// <summary>
+    /// The thread running the search started with startSearch.
+    /// </summary>
+    static std::thread backgroundSearchThread;
+
+    /// <summary>
+    /// The time the running search was started at.
+    /// </summary>
+    static std::chrono::steady_clock::time_point searchStartTime;
+
+    /// <summary>
+    /// The transposition table shared by all search threads.
+    /// The table is allocated with the default size on the first best move search if the size is not set before.
+    /// </summary>
+    static TranspositionTable transpositionTable;
+
+    /// <summary>
+    /// The persistent search threads. The main thread searches the root, and the other threads
+    /// help it by stealing the remaining moves of its split points (and the split points of each other).
+    /// While there is nothing to steal, the other threads search the root on their own with staggered depths
+    /// and share the results through the transposition table (Lazy SMP).
+    /// </summary>
+    static ThreadPool threadPool;
+
+    /// <summary>
+    /// Information about if the thread count has been set. If not, the thread pool is resized to the amount
+    /// of hardware threads on the first best move search.
+    /// </summary>
+    static bool threadCountSet;
+
+    /// <summary>
+    /// The split point queues of the search threads, indexed with the thread index.
+    /// </summary>
+    static std::unique_ptr<SplitPointQueue[]> splitPointQueues;
+
+    /// <summary>
+    /// The mutex the idle helper threads wait for new split points with.
+    /// </summary>
+    static std::mutex idleHelperMutex;
+
+    /// <summary>
+    /// Condition variable notified when a split point is published or the search is stopped.
+    /// </summary>
+    static std::condition_variable idleHelperCondition;
+
+    /// <summary>
+    /// The amount of notifications of the idle helper threads, used to detect the notifications
+    /// sent between looking for work and starting to wait. Changed only while idleHelperMutex is locked.
+    /// </summary>
+    static std::atomic<unsigned long long> idleHelperNotificationCount;
+
+    /// <summary>
+    /// The depth the main thread is searching, used to stagger the depths of the helper root searches.
+    /// </summary>
+    static std::atomic<int> mainThreadDepth;
+
+    /// <summary>
+    /// The node counters of the search threads, indexed with the thread index.
+    /// </summary>
+    static std::unique_ptr<NodeCounter[]> nodeCounters;
+
+    /// <summary>
+    /// The move ordering histories of the search threads, indexed with the thread index.
+    /// </summary>
+    static std::unique_ptr<SearchHistory[]> searchHistories;
+
+    /// <summary>
+    /// The amount of nodes searched in the subtrees of the root moves at the latest root search, indexed with
+    /// the index of the move in the root move list. Used to order the root moves for the next depth,
+    /// as the moves with bigger subtrees were harder to refute. The nodes searched by the helper threads
+    /// under the deeper split points of a move are not counted.
+    /// </summary>
+    static std::atomic<unsigned long long> rootMoveNodes[MAX_MOVES];
+
+    /// <summary>
+    /// The late move reductions indexed with the remaining depth and the move number (both limited to 63).
+    /// </summary>
+    static int lateMoveReductions[64][64];
+
+    /// <summary>
+    /// Flag that is set when the late move reductions have been calculated.
+    /// </summary>
+    static const bool lateMoveReductionsInitialized;
+
+    /// <summary>
+    /// Calculates the late move reductions.
+    /// </summary>
+    /// <returns>True when the reductions are calculated</returns>
+    static bool initializeLateMoveReductions();
+
+    /// <summary>
+    /// The depth reduction of the given move of a node. Late quiet moves that don't give check are reduced
+    /// when the side to move is not in check, as the earlier moves are the likely best moves.
+    /// </summary>
+    /// <param name="state">The game state after the move has been made</param>
+    /// <param name="move">The move</param>
+    /// <param name="isCheck">Whether the side to move was in check before the move</param>
+    /// <param name="depth">The remaining depth of the node</param>
+    /// <param name="moveNumber">The number of the move in the search order of the node (counted from 1)</param>
+    /// <returns>The amount of plies to reduce the search depth of the move</returns>
+    static int lateMoveReduction(const GameState& state, const Move& move, bool isCheck, int depth, int moveNumber);
+
+    /// <summary>
+    /// The index of the search thread running on the current thread.
+    /// </summary>
+    static thread_local int searchThreadIndex;
+
+    /// <summary>
+    /// The innermost split point the current thread is searching moves of, or null if there is none.
+    /// </summary>
+    static thread_local const SplitPoint* activeSplitPoint;
+
+    /// <summary>
+    /// Flag telling that the current thread is a helper thread searching the root on its own (Lazy SMP),
+    /// as there were no split points to help with.
+    /// </summary>
+    static thread_local bool helperRootSearch;
+
+    /// <summary>
+    /// The value of idleHelperNotificationCount when the helper root search of the current thread started.
+    /// The helper root search is aborted when the idle helpers are notified of a new split point.
+    /// </summary>
+    static thread_local unsigned long long helperRootSearchNotificationCount;
+
+    /// <summary>
+    /// Resets the stop flags for a new search.
+    /// </summary>
+    /// <param name="ponder">If the new search is a ponder search</param>
+    static void resetStop(bool ponder);
+
+    /// <summary>
+    /// Runs a best move search on the search thread pool. The stop flags must have been reset with resetStop.
+    /// </summary>
+    /// <param name="state">The game state to search move for</param>
+    /// <param name="limits">The search limits</param>
+    /// <returns>The search result, whose best move is Move(0, 0, 0, 0) if no moves found</returns>
+    static SearchResult search(const GameState& state, const SearchLimits& limits);
+
+    /// <summary>
+    /// Iterative deepening search of the main search thread. Decides the best move of the search and reports
+    /// the progress. Stops the other search threads when finished.
+    /// </summary>
+    /// <param name="state">The root game state</param>
+    /// <param name="moves">The legal moves of the root game state</param>
+    /// <param name="limits">The search limits</param>
+    /// <returns>The search result</returns>
+    static SearchResult searchMainThread(const GameState& state, MoveList moves, const SearchLimits& limits);
+
+    /// <summary>
+    /// Reconstructs the principal variation of the given best move by following the best moves stored
+    /// in the transposition table. The line ends at a missing or invalid move or a repetition.
+    /// </summary>
+    /// <param name="state">The root game state (unchanged when the function returns)</param>
+    /// <param name="bestMove">The best move of the root game state</param>
+    /// <param name="principalVariation">Move list that gets the principal variation starting with the best move</param>
+    static void collectPrincipalVariation(GameState& state, const Move& bestMove, MoveList& principalVariation);
+
+    /// <summary>
+    /// The amount of nodes searched by all threads in the running search.
+    /// </summary>
+    /// <returns>The amount of nodes</returns>
+    static unsigned long long searchedNodes();
+
+    /// <summary>
+    /// Counts a searched node for the current thread.
+    /// </summary>
+    static void countNode() {
+        std::atomic<unsigned long long>& nodes = nodeCounters[searchThreadIndex].nodes;
+        nodes.store(nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /// <summary>
+    /// The loop of a helper search thread. Steals split points from the other threads and searches
+    /// their moves until the search is stopped. When there are no split points to steal, the thread searches
+    /// the root on its own with the shared transposition table (Lazy SMP), every other helper one ply deeper
+    /// than the main thread, until a split point is published. The thread sleeps when it has searched
+    /// the maximum depth and there is nothing to steal.
+    /// </summary>
+    /// <param name="state">The root game state</param>
+    /// <param name="moves">The legal moves of the root game state</param>
+    /// <param name="maxDepth">The maximum evaluation depth</param>
+    static void searchHelperThread(const GameState& state, MoveList moves, int maxDepth);
+
+    /// <summary>
+    /// Wakes up the idle helper threads to look for new split points or to notice that the search is stopped.
+    /// </summary>
+    static void notifyIdleHelpers();
+
+    /// <summary>
+    /// Evaluates the root moves with the negamax function to the given depth.
+    /// The first move is searched with the full window and the other moves with principal variation search,
+    /// the best value found so far being the alpha of the next moves. The search stops at the first move
+    /// whose value is at least beta. If all values are at most alpha, the returned value is only an upper bound.
+    /// The moves are made and unmade on the given game state, so the game state is unchanged when the function returns.
+    /// The search of the main thread records the node counts of the root moves and splits the root.
+    /// </summary>
+    /// <param name="state">The root game state</param>
+    /// <param name="undoStack">The undo record stack of the search thread</param>
+    /// <param name="moves">The root moves in the order they are searched</param>
     /// <param name="depth">The evaluation depth</param>
-    /// <param name="isWhite">If evaluation should be done from the perspective of white</param>
-    static void runMinimax(const GameState& state, int stateIndex, int depth, bool isWhite);
+    /// <param name="alpha">The lower bound of the search window</param>
+    /// <param name="beta">The upper bound of the search window</param>
+    /// <param name="bestMoveIndex">Reference parameter that gets the index of the best move</param>
+    /// <returns>The evaluation value of the best move from the perspective of the side to move</returns>
+    static int searchRoot(GameState& state, UndoRecord* undoStack, const MoveList& moves, int depth, int alpha, int beta, int& bestMoveIndex);
+
+    /// <summary>
+    /// Checks if the current thread should abort its search, because the time limit has been exceeded,
+    /// a split point the thread is searching under has got a cutoff or a helper root search should give way
+    /// to a new split point.
+    /// </summary>
+    /// <returns>True if the search should be aborted</returns>
+    static bool searchAborted();
+
+    /// <summary>
+    /// Checks if the moves of a node with the given remaining depth can be searched in parallel.
+    /// The nodes of the helper root searches are not split.
+    /// </summary>
+    /// <param name="depth">The remaining depth of the node</param>
+    /// <returns>True if the node can be split</returns>
+    static bool canSplit(int depth);
+
+    /// <summary>
+    /// Searches the remaining moves of a node in parallel with the idle threads (Young Brothers Wait).
+    /// Publishes the node as a split point, searches its moves together with the threads that steal it
+    /// and waits for the helpers to finish. The bounds and the best evaluation value and move of the node
+    /// are updated to the reference parameters. The values are from the perspective of the side to move.
+    /// </summary>
+    /// <param name="state">The game state of the node (unchanged when the function returns)</param>
+    /// <param name="undoStack">The next free record of the undo record stack of the search thread</param>
+    /// <param name="moves">The ordered pseudo-legal moves of the node</param>
+    /// <param name="legalityMasks">The legality masks of the game state of the node</param>
+    /// <param name="firstMoveIndex">The index of the first move that has not been searched</param>
+    /// <param name="searchedMoveCount">The amount of legal moves of the node searched before the split</param>
+    /// <param name="ply">The distance of the node from the root</param>
+    /// <param name="depth">The remaining depth of the node</param>
+    /// <param name="alpha">The alpha value of the node</param>
+    /// <param name="beta">The beta value of the node</param>
+    /// <param name="bestEval">The best evaluation value of the node</param>
+    /// <param name="bestMove">The best move of the node</param>
+    /// <param name="searchedQuietMoves">The quiet moves of the node searched before the split without a cutoff</param>
+    /// <param name="searchedQuietMoveCount">The amount of the searched quiet moves</param>
+    static void split(GameState& state, UndoRecord* undoStack, const MoveList& moves, const LegalityMasks& legalityMasks, int firstMoveIndex, int searchedMoveCount, int ply, int depth, int& alpha, int beta, int& bestEval, Move& bestMove, const Move* searchedQuietMoves, int searchedQuietMoveCount);
+
+    /// <summary>
+    /// Searches moves of the split point until it has no moves left or gets a cutoff.
+    /// Used by both the owner thread and the helper threads of the split point.
+    /// </summary>
+    /// <param name="splitPoint">The split point</param>
+    /// <param name="state">The game state of the split point owned by the calling thread (unchanged when the function returns)</param>
+    /// <param name="undoStack">The next free record of the undo record stack of the calling thread</param>
+    static void searchSplitPoint(SplitPoint& splitPoint, GameState& state, UndoRecord* undoStack);
+
+    /// <summary>
+    /// Finds a split point with unsearched moves from the queues of the other threads and joins it as a helper.
+    /// The caller must leave the split point by decrementing its helper count when finished.
+    /// </summary>
+    /// <param name="ancestor">If not null, only the split points created under this split point are joined</param>
+    /// <returns>The joined split point, or null if there is no work to steal</returns>
+    static SplitPoint* stealSplitPoint(const SplitPoint* ancestor = nullptr);
+
+    /// <summary>
+    /// Leaves a split point joined with stealSplitPoint by decrementing its helper count.
+    /// Wakes the owner thread if it is waiting for the last helper.
+    /// </summary>
+    /// <param name="splitPoint">The split point to leave</param>
+    static void leaveSplitPoint(SplitPoint& splitPoint);
     
     /// <summary>
-    /// Recursive implementation of the Minimax algorithm with Alpha-Beta pruning.
+    /// Converts an evaluation value relative to the root to the value stored in the transposition table.
+    /// The checkmate values are stored relative to the stored game state, so they stay correct when
+    /// the game state is reached at another ply.
+    /// </summary>
+    /// <param name="value">The evaluation value relative to the root</param>
+    /// <param name="ply">The distance of the game state from the root</param>
+    /// <returns>The value to store</returns>
+    static int valueToTranspositionTable(int value, int ply) {
+        return value > CHECKMATE_THRESHOLD ? value + ply : value < -CHECKMATE_THRESHOLD ? value - ply : value;
+    }
+
+    /// <summary>
+    /// Converts an evaluation value stored in the transposition table to a value relative to the root.
+    /// </summary>
+    /// <param name="value">The stored evaluation value</param>
+    /// <param name="ply">The distance of the game state from the root</param>
+    /// <returns>The evaluation value relative to the root</returns>
+    static int valueFromTranspositionTable(int value, int ply) {
+        return value > CHECKMATE_THRESHOLD ? value - ply : value < -CHECKMATE_THRESHOLD ? value + ply : value;
+    }
+
+    /// <summary>
+    /// Recursive implementation of the Negamax algorithm with Alpha-Beta pruning, null move pruning,
+    /// late move reductions and late move pruning.
+    /// The evaluation values are from the perspective of the side to move, so the value of a child node
+    /// is the negation of its own value and the bounds of the child are the negated and swapped bounds of the node.
+    /// The moves are made and unmade on the given game state, so the game state is unchanged when the function returns.
     /// </summary>
     /// <param name="state">Current game state</param>
+    /// <param name="undoStack">The next free record of the undo record stack of the search thread</param>
+    /// <param name="ply">The distance of the current state from the root</param>
     /// <param name="depth">Current depth in the search tree</param>
-    /// <param name="isMaximizingPlayer">Whether current player is maximizing</param>
-    /// <param name="playerIsWhite">Whether the evaluating player is white</param>
     /// <param name="alpha">Alpha value for pruning</param>
     /// <param name="beta">Beta value for pruning</param>
-    /// <returns>Evaluation score for the current state</returns>
-    static int minimax(const GameState& state, int depth, bool isMaximizingPlayer, bool playerIsWhite, int alpha = std::numeric_limits<int>::min(), int beta = std::numeric_limits<int>::max());
+    /// <returns>Evaluation score for the current state from the perspective of the side to move</returns>
+    static int negamax(GameState& state, UndoRecord* undoStack, int ply, int depth, int alpha = -INFINITE_EVALUATION_VALUE, int beta = INFINITE_EVALUATION_VALUE);
+
+    /// <summary>
+    /// Orders the root moves by the given best move first and the others by the node counts of their subtrees
+    /// at the latest root search (rootMoveNodes), the biggest subtree first.
+    /// </summary>
+    /// <param name="moves">The root moves in the order they were searched (the scores of the list are overwritten)</param>
+    /// <param name="bestMove">The best move found</param>
+    static void orderRootMoves(MoveList& moves, const Move& bestMove);
 
     /// <summary>
-    /// Orders game states by their initial evaluation.
+    /// Orders moves by the initial evaluation of the game states they lead to.
     /// </summary>
-    /// <param name="states">Vector of game states to order</param>
+    /// <param name="state">The game state the moves are made from (unchanged when the function returns)</param>
+    /// <param name="moves">Move list to order (the scores of the list are overwritten)</param>
+    /// <param name="undo">Undo record to use for making the moves</param>
     /// <param name="transpositionTableMove">The best move stored in the transposition table, give Move(0, 0, 0, 0) if not available</param>
-    /// <param name="isWhite">If evaluation should be done from perspective of white</param>
-    static void orderMoves(std::vector<GameState>& states, const Move& transpositionTableMove, bool isWhite);
+    static void orderMoves(GameState& state, MoveList& moves, UndoRecord& undo, const Move& transpositionTableMove);
 
     /// <summary>
     /// Quiescence search to evaluate tactical positions more accurately.
     /// Only considers capturing moves to reach a "quiet" position.
+    /// The moves are made and unmade on the given game state, so the game state is unchanged when the function returns.
     /// </summary>
     /// <param name="state">Current game state</param>
-    /// <param name="playerIsWhite">Whether the evaluating player is white</param>
+    /// <param name="undoStack">The next free record of the undo record stack of the search thread</param>
     /// <param name="alpha">Alpha value for pruning</param>
     /// <param name="beta">Beta value for pruning</param>
     /// <param name="depth">Current quiescence search depth</param>
-    /// <returns>Evaluation score for the quiet position</returns>
-    static int quiescenceSearch(const GameState& state, bool playerIsWhite, int alpha, int beta, int depth = 4);
+    /// <returns>Evaluation score for the quiet position from the perspective of the side to move</returns>
+    static int quiescenceSearch(GameState& state, UndoRecord* undoStack, int alpha, int beta, int depth = QUIESCENCE_SEARCH_DEPTH);
 
 };
 
@@ -1,8 +1,11 @@
 #include <locale>
 #include <codecvt>
 #include <iostream>
+#include <sstream>
+#include <algorithm>
 #include "gameState.h"
-#include "gameInfo.h"
+#include "zobrist.h"
+#include "../bitboard.h"
 #include "../move.h"
 
 #include "../pieces/rook.h"
@@ -28,10 +31,13 @@ bool GameState::operator==(const GameState& other) const {
     if (_lowerEnPassantColumn != other._lowerEnPassantColumn)
         return false;
 
-    for (char i = 0; i < 8; i++)
-        for (char j = 0; j < 8; j++)
-            if (_board[i][j] != other._board[i][j])
-                return false;
+    for (int i = 0; i < 6; i++)
+        if (_pieceTypeBitboards[i] != other._pieceTypeBitboards[i])
+            return false;
+
+    for (int i = 0; i < 2; i++)
+        if (_colorBitboards[i] != other._colorBitboards[i])
+            return false;
 
     return true;
 }
@@ -41,106 +47,353 @@ bool GameState::operator!=(const GameState& other) const {
 }
 
 GameState::GameState() {
-    // Initialize board row 1 (index 0)
-    _board[0][0] = GameInfo::getInstance()->getPieceInstance(PieceType::Rook, false);
-    _board[0][1] = GameInfo::getInstance()->getPieceInstance(PieceType::Knight, false);
-    _board[0][2] = GameInfo::getInstance()->getPieceInstance(PieceType::Bishop, false);
-    _board[0][3] = GameInfo::getInstance()->getPieceInstance(PieceType::Queen, false);
-    _board[0][4] = GameInfo::getInstance()->getPieceInstance(PieceType::King, false);
-    _board[0][5] = GameInfo::getInstance()->getPieceInstance(PieceType::Bishop, false);
-    _board[0][6] = GameInfo::getInstance()->getPieceInstance(PieceType::Knight, false);
-    _board[0][7] = GameInfo::getInstance()->getPieceInstance(PieceType::Rook, false);
-
-    // Initialize board row 2 (index 1)
+    // Initialize the pieces of both colors to their starting squares
+    _pieceTypeBitboards[static_cast<int>(PieceType::Rook)] = squareBitboard(squareIndex(0, 0)) | squareBitboard(squareIndex(7, 0)) | squareBitboard(squareIndex(0, 7)) | squareBitboard(squareIndex(7, 7));
+    _pieceTypeBitboards[static_cast<int>(PieceType::Knight)] = squareBitboard(squareIndex(1, 0)) | squareBitboard(squareIndex(6, 0)) | squareBitboard(squareIndex(1, 7)) | squareBitboard(squareIndex(6, 7));
+    _pieceTypeBitboards[static_cast<int>(PieceType::Bishop)] = squareBitboard(squareIndex(2, 0)) | squareBitboard(squareIndex(5, 0)) | squareBitboard(squareIndex(2, 7)) | squareBitboard(squareIndex(5, 7));
+    _pieceTypeBitboards[static_cast<int>(PieceType::Queen)] = squareBitboard(squareIndex(3, 0)) | squareBitboard(squareIndex(3, 7));
+    _pieceTypeBitboards[static_cast<int>(PieceType::King)] = squareBitboard(squareIndex(4, 0)) | squareBitboard(squareIndex(4, 7));
+    _pieceTypeBitboards[static_cast<int>(PieceType::Pawn)] = 0;
     for (char x = 0; x < 8; x++) {
-        _board[1][x] = GameInfo::getInstance()->getPieceInstance(PieceType::Pawn, false);
+        _pieceTypeBitboards[static_cast<int>(PieceType::Pawn)] |= squareBitboard(squareIndex(x, 1)) | squareBitboard(squareIndex(x, 6));
     }
 
-    // Initialize board rows 3-6 (index 2-5)
-    for (char y = 2; y < 6; y++) {
-        for (char x = 0; x < 8; x++) {
-            _board[y][x] = 0;
-        }
+    // Initialize the color bitboards (rows 1-2 are black and rows 7-8 are white)
+    _colorBitboards[0] = 0xFFFF000000000000ULL;
+    _colorBitboards[1] = 0x000000000000FFFFULL;
+
+    calculateDerivedValues();
+}
+
+void GameState::calculateDerivedValues() {
+    // Calculate the game phase value
+    _gamePhase = 0;
+    uint64_t pieces = occupiedBitboard();
+    while (pieces) {
+        int square = popLeastSignificantSquare(pieces);
+        _gamePhase += PIECE_GAME_PHASE_INFLUENCES[pieceIndexAt(square) % 6];
     }
 
-    // Initialize board row 7 (index 6)
-    for (char x = 0; x < 8; x++) {
-        _board[6][x] = GameInfo::getInstance()->getPieceInstance(PieceType::Pawn, true);
+    // Calculate hash
+    _hash = 0;
+    if (_isWhiteSideToMove)
+        _hash = _hash xor ZOBRIST_VALUES.whiteSideToMove;
+    if (_upperLeftCastlingPossible)
+        _hash = _hash xor ZOBRIST_VALUES.upperLeftCastling;
+    if (_upperRightCastlingPossible)
+        _hash = _hash xor ZOBRIST_VALUES.upperRightCastling;
+    if (_lowerLeftCastlingPossible)
+        _hash = _hash xor ZOBRIST_VALUES.lowerLeftCastling;
+    if (_lowerRightCastlingPossible)
+        _hash = _hash xor ZOBRIST_VALUES.lowerRightCastling;
+    if (_upperEnPassantColumn != -1)
+        _hash = _hash xor ZOBRIST_VALUES.upperEnPassant[static_cast<int>(_upperEnPassantColumn)];
+    if (_lowerEnPassantColumn != -1)
+        _hash = _hash xor ZOBRIST_VALUES.lowerEnPassant[static_cast<int>(_lowerEnPassantColumn)];
+
+	// Calculate the piece hashes and the evaluation value
+    _evaluationValue = 0;
+    pieces = occupiedBitboard();
+    while (pieces) {
+        int square = popLeastSignificantSquare(pieces);
+        int pieceIndex = pieceIndexAt(square);
+
+        _hash = _hash xor ZOBRIST_VALUES.pieces[pieceIndex][square];
+        _evaluationValue += pieceSquareValue(pieceIndex, square, _gamePhase);
     }
+}
 
-    // Initialize board row 8 (index 7)
-    _board[7][0] = GameInfo::getInstance()->getPieceInstance(PieceType::Rook, true);
-    _board[7][1] = GameInfo::getInstance()->getPieceInstance(PieceType::Knight, true);
-    _board[7][2] = GameInfo::getInstance()->getPieceInstance(PieceType::Bishop, true);
-    _board[7][3] = GameInfo::getInstance()->getPieceInstance(PieceType::Queen, true);
-    _board[7][4] = GameInfo::getInstance()->getPieceInstance(PieceType::King, true);
-    _board[7][5] = GameInfo::getInstance()->getPieceInstance(PieceType::Bishop, true);
-    _board[7][6] = GameInfo::getInstance()->getPieceInstance(PieceType::Knight, true);
-    _board[7][7] = GameInfo::getInstance()->getPieceInstance(PieceType::Rook, true);
+bool GameState::fromFEN(const std::string& fen, GameState& state) {
+    std::istringstream input(fen);
+    std::string placement, sideToMove, castling, enPassant;
+    if (!(input >> placement >> sideToMove >> castling >> enPassant))
+        return false;
 
-    // Calculate the game phase value
-    for (char i = 0; i < 8; i++) {
-        for (char j = 0; j < 8; j++) {
-            if (_board[j][i] == 0)
-                continue;
+    GameState newState(state);
+    for (int i = 0; i < 6; i++)
+        newState._pieceTypeBitboards[i] = 0;
+    newState._colorBitboards[0] = 0;
+    newState._colorBitboards[1] = 0;
+
+    // Parse the piece placement (the ranks from 8 to 1, which are the rows from 0 to 7)
+    const std::string pieceChars = "BKNPQRbknpqr";
+    int x = 0, y = 0;
+    for (char c : placement) {
+        if (c == '/') {
+            if (x != 8)
+                return false;
+            x = 0;
+            y++;
+        }
+        else if (c >= '1' && c <= '8') {
+            x += c - '0';
+        }
+        else {
+            size_t pieceIndex = pieceChars.find(c);
+            if (pieceIndex == std::string::npos || x >= 8 || y >= 8)
+                return false;
 
-            _gamePhase += _board[j][i]->gamePhaseInfluence();
+            newState._pieceTypeBitboards[pieceIndex % 6] |= squareBitboard(squareIndex(x, y));
+            newState._colorBitboards[pieceIndex / 6] |= squareBitboard(squareIndex(x, y));
+            x++;
         }
+
+        if (x > 8)
+            return false;
     }
+    if (x != 8 || y != 7)
+        return false;
 
-    // Calculate hash
-    _hash = _hash xor GameInfo::getInstance()->whiteSideToMoveZobristValue();
-    _hash = _hash xor GameInfo::getInstance()->upperLeftCastlingZobristValue();
-    _hash = _hash xor GameInfo::getInstance()->upperRightCastlingZobristValue();
-    _hash = _hash xor GameInfo::getInstance()->lowerLeftCastlingZobristValue();
-    _hash = _hash xor GameInfo::getInstance()->lowerRightCastlingZobristValue();
-
-    for (char i = 0; i < 8; i++) {
-        for (char j = 0; j < 8; j++) {
-            if (_board[j][i] == 0)
-                continue;
+    // Both sides must have exactly one king
+    if (squareCount(newState.pieceBitboard(PieceType::King, true)) != 1 || squareCount(newState.pieceBitboard(PieceType::King, false)) != 1)
+        return false;
+
+    // Parse the side to move
+    if (sideToMove != "w" && sideToMove != "b")
+        return false;
+    newState._isWhiteSideToMove = sideToMove == "w";
+
+    // The side that is not to move can't be in check, as its king could be captured
+    if (newState.isCheck(!newState._isWhiteSideToMove))
+        return false;
 
-            _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[j][i]->getType(), _board[j][i]->isWhite(), i, j);
+    // Parse the castling rights (black is the upper side)
+    // A castling right is only kept if the king and the rook are on their starting squares
+    auto pieceIsAt = [&newState](PieceType type, bool isWhite, int x, int y) {
+        return (newState.pieceBitboard(type, isWhite) & squareBitboard(squareIndex(x, y))) != 0;
+    };
+    newState._upperLeftCastlingPossible = castling.find('q') != std::string::npos && pieceIsAt(PieceType::King, false, 4, 0) && pieceIsAt(PieceType::Rook, false, 0, 0);
+    newState._upperRightCastlingPossible = castling.find('k') != std::string::npos && pieceIsAt(PieceType::King, false, 4, 0) && pieceIsAt(PieceType::Rook, false, 7, 0);
+    newState._lowerLeftCastlingPossible = castling.find('Q') != std::string::npos && pieceIsAt(PieceType::King, true, 4, 7) && pieceIsAt(PieceType::Rook, true, 0, 7);
+    newState._lowerRightCastlingPossible = castling.find('K') != std::string::npos && pieceIsAt(PieceType::King, true, 4, 7) && pieceIsAt(PieceType::Rook, true, 7, 7);
+
+    // Parse the en passant target square (the square behind the pawn that made the double move)
+    // The square is only kept if the side to move can capture the pawn that made the double move
+    newState._upperEnPassantColumn = -1;
+    newState._lowerEnPassantColumn = -1;
+    if (enPassant != "-") {
+        if (enPassant.length() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' || (enPassant[1] != '6' && enPassant[1] != '3'))
+            return false;
+
+        int column = enPassant[0] - 'a';
+        bool isUpperDoubleMove = enPassant[1] == '6';
+        int targetY = isUpperDoubleMove ? 2 : 5;
+        int pawnY = isUpperDoubleMove ? 3 : 4;
+        bool isWhiteSideToMove = newState._isWhiteSideToMove;
+        bool isCapturable = isUpperDoubleMove == isWhiteSideToMove
+            && pieceIsAt(PieceType::Pawn, !isWhiteSideToMove, column, pawnY)
+            && newState.pieceIndexAt(squareIndex(column, targetY)) == -1
+            && ((column > 0 && pieceIsAt(PieceType::Pawn, isWhiteSideToMove, column - 1, pawnY))
+                || (column < 7 && pieceIsAt(PieceType::Pawn, isWhiteSideToMove, column + 1, pawnY)));
+
+        if (isCapturable) {
+            if (isUpperDoubleMove)
+                newState._upperEnPassantColumn = column;
+            else
+                newState._lowerEnPassantColumn = column;
         }
     }
 
-	// Calculate evaluation value
-    _evaluationValue = 0;
-    for (char i = 0; i < 8; i++) {
-        for (char j = 0; j < 8; j++) {
-            if (_board[i][j] == 0)
+    newState._lastMove = Move(0, 0, 0, 0);
+    newState.calculateDerivedValues();
+
+    state = newState;
+    return true;
+}
+
+std::string GameState::toFEN() const {
+    std::string fen;
+
+    // Write the piece placement (the rows from 0 to 7, which are the ranks from 8 to 1)
+    const char* pieceChars = "BKNPQRbknpqr";
+    for (int y = 0; y < 8; y++) {
+        int emptySquares = 0;
+        for (int x = 0; x < 8; x++) {
+            int pieceIndex = pieceIndexAt(squareIndex(x, y));
+            if (pieceIndex == -1) {
+                emptySquares++;
                 continue;
+            }
 
-            _evaluationValue += _board[i][j]->evaluationValue(j, i, _gamePhase) * (_board[i][j]->isWhite() ? 1 : -1);
+            if (emptySquares > 0) {
+                fen += static_cast<char>('0' + emptySquares);
+                emptySquares = 0;
+            }
+            fen += pieceChars[pieceIndex];
         }
+
+        if (emptySquares > 0)
+            fen += static_cast<char>('0' + emptySquares);
+        if (y < 7)
+            fen += '/';
+    }
+
+    // Write the side to move
+    fen += _isWhiteSideToMove ? " w " : " b ";
+
+    // Write the castling rights (black is the upper side)
+    std::string castling;
+    if (_lowerRightCastlingPossible)
+        castling += 'K';
+    if (_lowerLeftCastlingPossible)
+        castling += 'Q';
+    if (_upperRightCastlingPossible)
+        castling += 'k';
+    if (_upperLeftCastlingPossible)
+        castling += 'q';
+    fen += castling.empty() ? "-" : castling;
+
+    // Write the en passant target square (the square behind the pawn that made the double move)
+    if (_upperEnPassantColumn != -1) {
+        fen += ' ';
+        fen += static_cast<char>('a' + _upperEnPassantColumn);
+        fen += '6';
     }
+    else if (_lowerEnPassantColumn != -1) {
+        fen += ' ';
+        fen += static_cast<char>('a' + _lowerEnPassantColumn);
+        fen += '3';
+    }
+    else {
+        fen += " -";
+    }
+
+    fen += " 0 1";
+    return fen;
+}
+
+int GameState::pieceIndexAt(int square) const {
+    uint64_t squareBit = squareBitboard(square);
+    if (!((_colorBitboards[0] | _colorBitboards[1]) & squareBit))
+        return -1;
+
+    bool isWhite = (_colorBitboards[0] & squareBit) != 0;
+    for (int type = 0; type < 6; type++) {
+        if (_pieceTypeBitboards[type] & squareBit)
+            return pieceIndex(static_cast<PieceType>(type), isWhite);
+    }
+
+    return -1;
+}
+
+void GameState::putPiece(int pieceIndex, int square) {
+    _pieceTypeBitboards[pieceIndex % 6] |= squareBitboard(square);
+    _colorBitboards[pieceIndex / 6] |= squareBitboard(square);
+
+    _gamePhase += PIECE_GAME_PHASE_INFLUENCES[pieceIndex % 6];
+    _hash = _hash xor ZOBRIST_VALUES.pieces[pieceIndex][square];
+    _evaluationValue += pieceSquareValue(pieceIndex, square, _gamePhase);
+}
+
+void GameState::removePiece(int pieceIndex, int square) {
+    _pieceTypeBitboards[pieceIndex % 6] &= ~squareBitboard(square);
+    _colorBitboards[pieceIndex / 6] &= ~squareBitboard(square);
+
+    _gamePhase -= PIECE_GAME_PHASE_INFLUENCES[pieceIndex % 6];
+    _hash = _hash xor ZOBRIST_VALUES.pieces[pieceIndex][square];
+    _evaluationValue -= pieceSquareValue(pieceIndex, square, _gamePhase);
+}
+
+void GameState::movePiece(int pieceIndex, int fromSquare, int toSquare) {
+    uint64_t moveBits = squareBitboard(fromSquare) | squareBitboard(toSquare);
+
+    _pieceTypeBitboards[pieceIndex % 6] ^= moveBits;
+    _colorBitboards[pieceIndex / 6] ^= moveBits;
+
+    _hash = _hash xor ZOBRIST_VALUES.pieces[pieceIndex][fromSquare];
+    _hash = _hash xor ZOBRIST_VALUES.pieces[pieceIndex][toSquare];
+    _evaluationValue -= pieceSquareValue(pieceIndex, fromSquare, _gamePhase);
+    _evaluationValue += pieceSquareValue(pieceIndex, toSquare, _gamePhase);
+}
+
+void GameState::toggleSquare(int pieceIndex, int square) {
+    _pieceTypeBitboards[pieceIndex % 6] ^= squareBitboard(square);
+    _colorBitboards[pieceIndex / 6] ^= squareBitboard(square);
+}
+
+void GameState::saveUndoRecord(UndoRecord& undo) const {
+    undo.lastMove = _lastMove;
+    undo.hash = _hash;
+    undo.evaluationValue = _evaluationValue;
+    undo.capturedPiece = -1;
+    undo.capturedSquare = -1;
+    undo.gamePhase = _gamePhase;
+    undo.upperEnPassantColumn = _upperEnPassantColumn;
+    undo.lowerEnPassantColumn = _lowerEnPassantColumn;
+    undo.upperLeftCastlingPossible = _upperLeftCastlingPossible;
+    undo.upperRightCastlingPossible = _upperRightCastlingPossible;
+    undo.lowerLeftCastlingPossible = _lowerLeftCastlingPossible;
+    undo.lowerRightCastlingPossible = _lowerRightCastlingPossible;
+}
+
+void GameState::restoreUndoRecord(const UndoRecord& undo) {
+    _lastMove = undo.lastMove;
+    _hash = undo.hash;
+    _evaluationValue = undo.evaluationValue;
+    _gamePhase = undo.gamePhase;
+    _upperEnPassantColumn = undo.upperEnPassantColumn;
+    _lowerEnPassantColumn = undo.lowerEnPassantColumn;
+    _upperLeftCastlingPossible = undo.upperLeftCastlingPossible;
+    _upperRightCastlingPossible = undo.upperRightCastlingPossible;
+    _lowerLeftCastlingPossible = undo.lowerLeftCastlingPossible;
+    _lowerRightCastlingPossible = undo.lowerRightCastlingPossible;
+    _isWhiteSideToMove = !_isWhiteSideToMove;
 }
 
 void GameState::applyMove(const Move& move) {
+    UndoRecord undo;
+    makeMove(move, undo);
+}
+
+void GameState::makeMove(const Move& move, UndoRecord& undo) {
+    // Save the values needed for undoing the move
+    saveUndoRecord(undo);
+
     // Update the last move
 	_lastMove = move;
 
     // Change the side to move
     _isWhiteSideToMove = !_isWhiteSideToMove;
-    _hash = _hash xor GameInfo::getInstance()->whiteSideToMoveZobristValue();
+    _hash = _hash xor ZOBRIST_VALUES.whiteSideToMove;
+
+    int fromSquare = move.fromSquare();
+    int toSquare = move.toSquare();
 
     // Handle the move and capturing
-    if (_board[move.y2()][move.x2()] != 0) {
-        _gamePhase -= _board[move.y2()][move.x2()]->gamePhaseInfluence();
-        _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[move.y2()][move.x2()]->getType(), _board[move.y2()][move.x2()]->isWhite(), move.x2(), move.y2());
-        _evaluationValue -= _board[move.y2()][move.x2()]->evaluationValue(move.x2(), move.y2(), _gamePhase) * (_board[move.y2()][move.x2()]->isWhite() ? 1 : -1);
+    if (move.isCapture() && !move.isEnPassant()) {
+        int capturedPiece = pieceIndexAt(toSquare);
+        removePiece(capturedPiece, toSquare);
+        undo.capturedPiece = capturedPiece;
+        undo.capturedSquare = toSquare;
     }
 
-    _board[move.y2()][move.x2()] = _board[move.y1()][move.x1()];
-    _board[move.y1()][move.x1()] = 0;
+    int movingPiece = pieceIndexAt(fromSquare);
+    movePiece(movingPiece, fromSquare, toSquare);
+
+    bool isWhite = movingPiece < 6;
 
-    _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[move.y2()][move.x2()]->getType(), _board[move.y2()][move.x2()]->isWhite(), move.x1(), move.y1());
-    _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[move.y2()][move.x2()]->getType(), _board[move.y2()][move.x2()]->isWhite(), move.x2(), move.y2());
-    _evaluationValue -= _board[move.y2()][move.x2()]->evaluationValue(move.x1(), move.y1(), _gamePhase) * (_board[move.y2()][move.x2()]->isWhite() ? 1 : -1);
-    _evaluationValue += _board[move.y2()][move.x2()]->evaluationValue(move.x2(), move.y2(), _gamePhase) * (_board[move.y2()][move.x2()]->isWhite() ? 1 : -1);
+    switch (move.flags()) {
+    // Handle en passant move (the captured pawn is next to the 'from' square at the column of the 'to' square)
+    case Move::EnPassant: {
+        int capturedSquare = squareIndex(move.x2(), move.y1());
+        int capturedPawn = pieceIndex(PieceType::Pawn, !isWhite);
+        removePiece(capturedPawn, capturedSquare);
+        undo.capturedPiece = capturedPawn;
+        undo.capturedSquare = capturedSquare;
+        break;
+    }
+
+    // Handle castling moves
+    case Move::KingSideCastling:
+        movePiece(pieceIndex(PieceType::Rook, isWhite), squareIndex(7, move.y1()), squareIndex(5, move.y1()));
+        break;
+    case Move::QueenSideCastling:
+        movePiece(pieceIndex(PieceType::Rook, isWhite), squareIndex(0, move.y1()), squareIndex(3, move.y1()));
+        break;
+    }
 
     // Handle promotion
-    if (move.promotionPiece() != -1) {
+    if (move.isPromotion()) {
         PieceType promotionPieceType;
 		switch (move.promotionPiece()) {
 		case 'n':
@@ -157,163 +410,112 @@ void GameState::applyMove(const Move& move) {
             break;
 		}
 
-        Piece* promotionPiece = GameInfo::getInstance()->getPieceInstance(promotionPieceType, _board[move.y2()][move.x2()]->isWhite());
-
-        _gamePhase -= _board[move.y2()][move.x2()]->gamePhaseInfluence();
-        _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[move.y2()][move.x2()]->getType(), _board[move.y2()][move.x2()]->isWhite(), move.x2(), move.y2());
-        _evaluationValue -= _board[move.y2()][move.x2()]->evaluationValue(move.x2(), move.y2(), _gamePhase) * (_board[move.y2()][move.x2()]->isWhite() ? 1 : -1);
-
-        _board[move.y2()][move.x2()] = promotionPiece;
-
-        _gamePhase += _board[move.y2()][move.x2()]->gamePhaseInfluence();
-        _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[move.y2()][move.x2()]->getType(), _board[move.y2()][move.x2()]->isWhite(), move.x2(), move.y2());
-        _evaluationValue += _board[move.y2()][move.x2()]->evaluationValue(move.x2(), move.y2(), _gamePhase) * (_board[move.y2()][move.x2()]->isWhite() ? 1 : -1);
-    }
-
-    // Handle en passant move
-    if (_board[move.y2()][move.x2()]->getType() == PieceType::Pawn) {
-        if (move.y2() == 2 && upperEnPassantColumn() == move.x2()) {
-            if (_board[3][move.x2()] != 0) {
-                _gamePhase -= _board[3][move.x2()]->gamePhaseInfluence();
-                _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[3][move.x2()]->getType(), _board[3][move.x2()]->isWhite(), move.x2(), 3);
-                _evaluationValue -= _board[3][move.x2()]->evaluationValue(move.x2(), 3, _gamePhase) * (_board[3][move.x2()]->isWhite() ? 1 : -1);
-
-                _board[3][move.x2()] = 0;
-            }
-        } else if (move.y2() == 5 && lowerEnPassantColumn() == move.x2()) {
-            if (_board[4][move.x2()] != 0) {
-                _gamePhase -= _board[4][move.x2()]->gamePhaseInfluence();
-                _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[4][move.x2()]->getType(), _board[4][move.x2()]->isWhite(), move.x2(), 4);
-                _evaluationValue -= _board[4][move.x2()]->evaluationValue(move.x2(), 4, _gamePhase) * (_board[4][move.x2()]->isWhite() ? 1 : -1);
-
-                _board[4][move.x2()] = 0;
-            }
-        }
-    }
-
-    // Handle king move
-    if (_board[move.y2()][move.x2()]->getType() == PieceType::King) {
-		// Update king position
-        if (_board[move.y2()][move.x2()]->isWhite()) {
-			_whiteKingX = move.x2();
-			_whiteKingY = move.y2();
-        }
-        else {
-			_blackKingX = move.x2();
-			_blackKingY = move.y2();
-        }
-
-        // Handle castling moves
-        if (move.x2() == 2 && move.y2() == 0 && upperLeftCastlingPossible()) {
-            if (_board[0][3] != 0) {
-                _gamePhase -= _board[0][3]->gamePhaseInfluence();
-                _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[0][3]->getType(), _board[0][3]->isWhite(), 3, 0);
-                _evaluationValue -= _board[0][3]->evaluationValue(3, 0, _gamePhase) * (_board[0][3]->isWhite() ? 1 : -1);
-            }
-
-            _board[0][3] = _board[0][0];
-            _board[0][0] = 0;
-
-            _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[0][3]->getType(), _board[0][3]->isWhite(), 0, 0);
-            _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[0][3]->getType(), _board[0][3]->isWhite(), 3, 0);
-            _evaluationValue -= _board[0][3]->evaluationValue(0, 0, _gamePhase) * (_board[0][3]->isWhite() ? 1 : -1);
-            _evaluationValue += _board[0][3]->evaluationValue(3, 0, _gamePhase) * (_board[0][3]->isWhite() ? 1 : -1);
-        }
-        else if (move.x2() == 6 && move.y2() == 0 && upperRightCastlingPossible()) {
-            if (_board[0][5] != 0) {
-                _gamePhase -= _board[0][5]->gamePhaseInfluence();
-                _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[0][5]->getType(), _board[0][5]->isWhite(), 5, 0);
-                _evaluationValue -= _board[0][5]->evaluationValue(5, 0, _gamePhase) * (_board[0][5]->isWhite() ? 1 : -1);
-            }
-
-            _board[0][5] = _board[0][7];
-            _board[0][7] = 0;
-
-            _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[0][5]->getType(), _board[0][5]->isWhite(), 7, 0);
-            _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[0][5]->getType(), _board[0][5]->isWhite(), 5, 0);
-            _evaluationValue -= _board[0][5]->evaluationValue(7, 0, _gamePhase) * (_board[0][5]->isWhite() ? 1 : -1);
-            _evaluationValue += _board[0][5]->evaluationValue(5, 0, _gamePhase) * (_board[0][5]->isWhite() ? 1 : -1);
-        }
-        else if (move.x2() == 2 && move.y2() == 7 && lowerLeftCastlingPossible()) {
-            if (_board[7][3] != 0) {
-                _gamePhase -= _board[7][3]->gamePhaseInfluence();
-                _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[7][3]->getType(), _board[7][3]->isWhite(), 3, 7);
-                _evaluationValue -= _board[7][3]->evaluationValue(3, 7, _gamePhase) * (_board[7][3]->isWhite() ? 1 : -1);
-            }
-
-            _board[7][3] = _board[7][0];
-            _board[7][0] = 0;
-
-            _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[7][3]->getType(), _board[7][3]->isWhite(), 0, 7);
-            _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[7][3]->getType(), _board[7][3]->isWhite(), 3, 7);
-            _evaluationValue -= _board[7][3]->evaluationValue(0, 7, _gamePhase) * (_board[7][3]->isWhite() ? 1 : -1);
-            _evaluationValue += _board[7][3]->evaluationValue(3, 7, _gamePhase) * (_board[7][3]->isWhite() ? 1 : -1);
-        }
-        else if (move.x2() == 6 && move.y2() == 7 && lowerRightCastlingPossible()) {
-            if (_board[7][5] != 0) {
-                _gamePhase -= _board[7][5]->gamePhaseInfluence();
-                _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[7][5]->getType(), _board[7][5]->isWhite(), 5, 7);
-                _evaluationValue -= _board[7][5]->evaluationValue(5, 7, _gamePhase) * (_board[7][5]->isWhite() ? 1 : -1);
-            }
-
-            _board[7][5] = _board[7][7];
-            _board[7][7] = 0;
-            
-            _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[7][5]->getType(), _board[7][5]->isWhite(), 7, 7);
-            _hash = _hash xor GameInfo::getInstance()->pieceZobristValue(_board[7][5]->getType(), _board[7][5]->isWhite(), 5, 7);
-            _evaluationValue -= _board[7][5]->evaluationValue(7, 7, _gamePhase) * (_board[7][5]->isWhite() ? 1 : -1);
-            _evaluationValue += _board[7][5]->evaluationValue(5, 7, _gamePhase) * (_board[7][5]->isWhite() ? 1 : -1);
-        }
+        removePiece(movingPiece, toSquare);
+        putPiece(pieceIndex(promotionPieceType, isWhite), toSquare);
     }
 
     // Update en passant flags
     if (_upperEnPassantColumn != -1) {
-        _hash = _hash xor GameInfo::getInstance()->upperEnPassantZobristValue(_upperEnPassantColumn);
+        _hash = _hash xor ZOBRIST_VALUES.upperEnPassant[static_cast<int>(_upperEnPassantColumn)];
         _upperEnPassantColumn = -1;
     }
 
     if (_lowerEnPassantColumn != -1) {
-        _hash = _hash xor GameInfo::getInstance()->lowerEnPassantZobristValue(_lowerEnPassantColumn);
+        _hash = _hash xor ZOBRIST_VALUES.lowerEnPassant[static_cast<int>(_lowerEnPassantColumn)];
         _lowerEnPassantColumn = -1;
     }
 
-    if (_board[move.y2()][move.x2()]->getType() == PieceType::Pawn) {
-        if (move.y2() == 3 && move.y2() - move.y1() == 2) {
+    if (move.flags() == Move::DoublePawnPush) {
+        if (move.y2() == 3) {
             _upperEnPassantColumn = move.x2();
-            _hash = _hash xor GameInfo::getInstance()->upperEnPassantZobristValue(_upperEnPassantColumn);
+            _hash = _hash xor ZOBRIST_VALUES.upperEnPassant[static_cast<int>(_upperEnPassantColumn)];
         }
-        else if (move.y2() == 4 && move.y2() - move.y1() == -2) {
+        else {
             _lowerEnPassantColumn = move.x2();
-            _hash = _hash xor GameInfo::getInstance()->lowerEnPassantZobristValue(_lowerEnPassantColumn);
+            _hash = _hash xor ZOBRIST_VALUES.lowerEnPassant[static_cast<int>(_lowerEnPassantColumn)];
         }
     }
 
     // Update castling flags
-    if (_upperLeftCastlingPossible && (((move.x1() == 4 && move.y1() == 0) || move.x1() == 0 && move.y1() == 0) || (move.x2() == 0 && move.y2() == 0))) {
+    if (_upperLeftCastlingPossible && ((move.x1() == 4 && move.y1() == 0) || (move.x1() == 0 && move.y1() == 0) || (move.x2() == 0 && move.y2() == 0))) {
         _upperLeftCastlingPossible = false;
-        _hash = _hash xor GameInfo::getInstance()->upperLeftCastlingZobristValue();
+        _hash = _hash xor ZOBRIST_VALUES.upperLeftCastling;
     }
     if (_upperRightCastlingPossible && ((move.x1() == 4 && move.y1() == 0) || (move.x1() == 7 && move.y1() == 0) || (move.x2() == 7 && move.y2() == 0))) {
         _upperRightCastlingPossible = false;
-        _hash = _hash xor GameInfo::getInstance()->upperRightCastlingZobristValue();
+        _hash = _hash xor ZOBRIST_VALUES.upperRightCastling;
     }
     if (_lowerLeftCastlingPossible && ((move.x1() == 4 && move.y1() == 7) || (move.x1() == 0 && move.y1() == 7) || (move.x2() == 0 && move.y2() == 7))) {
         _lowerLeftCastlingPossible = false;
-        _hash = _hash xor GameInfo::getInstance()->lowerLeftCastlingZobristValue();
+        _hash = _hash xor ZOBRIST_VALUES.lowerLeftCastling;
     }
     if (_lowerRightCastlingPossible && ((move.x1() == 4 && move.y1() == 7) || (move.x1() == 7 && move.y1() == 7) || (move.x2() == 7 && move.y2() == 7))) {
         _lowerRightCastlingPossible = false;
-        _hash = _hash xor GameInfo::getInstance()->lowerRightCastlingZobristValue();
+        _hash = _hash xor ZOBRIST_VALUES.lowerRightCastling;
     }
 }
 
+void GameState::unmakeMove(const UndoRecord& undo) {
+    const Move move = _lastMove;
+    int fromSquare = move.fromSquare();
+    int toSquare = move.toSquare();
+
+    int movedPiece = pieceIndexAt(toSquare);
+    bool isWhite = movedPiece < 6;
+
+    // Move the castling rook back
+    if (move.flags() == Move::KingSideCastling) {
+        toggleSquare(pieceIndex(PieceType::Rook, isWhite), squareIndex(5, move.y1()));
+        toggleSquare(pieceIndex(PieceType::Rook, isWhite), squareIndex(7, move.y1()));
+    }
+    else if (move.flags() == Move::QueenSideCastling) {
+        toggleSquare(pieceIndex(PieceType::Rook, isWhite), squareIndex(3, move.y1()));
+        toggleSquare(pieceIndex(PieceType::Rook, isWhite), squareIndex(0, move.y1()));
+    }
+
+    // Move the piece back (a promoted piece turns back to a pawn)
+    toggleSquare(movedPiece, toSquare);
+    toggleSquare(move.isPromotion() ? pieceIndex(PieceType::Pawn, isWhite) : movedPiece, fromSquare);
+
+    // Put the captured piece back
+    if (undo.capturedPiece != -1) {
+        toggleSquare(undo.capturedPiece, undo.capturedSquare);
+    }
+
+    // Restore the rest of the values
+    restoreUndoRecord(undo);
+}
+
 void GameState::applyNullMove() {
+    UndoRecord undo;
+    makeNullMove(undo);
+}
+
+void GameState::makeNullMove(UndoRecord& undo) {
+    // Save the values needed for undoing the null move
+    saveUndoRecord(undo);
+
     // Update the last move
     _lastMove = Move(0, 0, 0, 0);
 
     // Change the side to move
     _isWhiteSideToMove = !_isWhiteSideToMove;
-    _hash = _hash xor GameInfo::getInstance()->whiteSideToMoveZobristValue();
+    _hash = _hash xor ZOBRIST_VALUES.whiteSideToMove;
+
+    // Clear the en passant flags
+    if (_upperEnPassantColumn != -1) {
+        _hash = _hash xor ZOBRIST_VALUES.upperEnPassant[static_cast<int>(_upperEnPassantColumn)];
+        _upperEnPassantColumn = -1;
+    }
+
+    if (_lowerEnPassantColumn != -1) {
+        _hash = _hash xor ZOBRIST_VALUES.lowerEnPassant[static_cast<int>(_lowerEnPassantColumn)];
+        _lowerEnPassantColumn = -1;
+    }
+}
+
+void GameState::unmakeNullMove(const UndoRecord& undo) {
+    restoreUndoRecord(undo);
 }
 
 void GameState::printBoard() const {
@@ -326,13 +528,17 @@ void GameState::printBoard() const {
         std::wcout << 8 - i << L" |";
         for (int j = 0; j < 8; ++j) {
             wchar_t pieceChar = L' ';
-            if (_board[i][j] != nullptr) {
-                if (dynamic_cast<Queen*>(_board[i][j])) pieceChar = _board[i][j]->isWhite() ? L'\u265B' : L'\u2655';
-                else if (dynamic_cast<Knight*>(_board[i][j])) pieceChar = _board[i][j]->isWhite() ? L'\u265E' : L'\u2658';
-                else if (dynamic_cast<Bishop*>(_board[i][j])) pieceChar = _board[i][j]->isWhite() ? L'\u265D' : L'\u2657';
-                else if (dynamic_cast<Rook*>(_board[i][j])) pieceChar = _board[i][j]->isWhite() ? L'\u265C' : L'\u2656';
-                else if (dynamic_cast<King*>(_board[i][j])) pieceChar = _board[i][j]->isWhite() ? L'\u265A' : L'\u2654';
-                else if (dynamic_cast<Pawn*>(_board[i][j])) pieceChar = _board[i][j]->isWhite() ? L'\u265F' : L'\u2659';
+            int piece = getPieceAt(j, i);
+            if (piece != -1) {
+                bool isWhite = isWhitePiece(piece);
+                switch (pieceTypeOf(piece)) {
+                case PieceType::Queen: pieceChar = isWhite ? L'\u265B' : L'\u2655'; break;
+                case PieceType::Knight: pieceChar = isWhite ? L'\u265E' : L'\u2658'; break;
+                case PieceType::Bishop: pieceChar = isWhite ? L'\u265D' : L'\u2657'; break;
+                case PieceType::Rook: pieceChar = isWhite ? L'\u265C' : L'\u2656'; break;
+                case PieceType::King: pieceChar = isWhite ? L'\u265A' : L'\u2654'; break;
+                case PieceType::Pawn: pieceChar = isWhite ? L'\u265F' : L'\u2659'; break;
+                }
             }
             else {
                 // Determine if the square is white or black
@@ -351,227 +557,247 @@ void GameState::printBoard() const {
     std::wcout << L"    a   b   c   d   e   f   g   h" << std::endl;
 }
 
-Piece* GameState::getPieceAt(char x, char y) const {
-    return _board[y][x];
+int GameState::getPieceAt(char x, char y) const {
+    return pieceIndexAt(squareIndex(x, y));
 }
 
-void GameState::possibleNewGameStates(std::vector<GameState>& newGameStates, bool captureOnly) const {
-    std::vector<Move> moves;
-	moves.reserve(32);
-
-    for (char i = 0; i < 8; i++) {
-        for (char j = 0; j < 8; j++) {
-            if (_board[i][j] == 0)
-                continue;
-            if (_board[i][j]->isWhite() != _isWhiteSideToMove)
-                continue;
-
-            _board[i][j]->possibleMoves(moves, j, i, *this, captureOnly);
-        }
+void GameState::possibleMoves(MoveList& moves, char x, char y, bool captureOnly) const {
+    int piece = pieceIndexAt(squareIndex(x, y));
+    if (piece == -1)
+        return;
+
+    bool isWhite = isWhitePiece(piece);
+    switch (pieceTypeOf(piece)) {
+    case PieceType::Bishop:
+        Bishop::possibleMoves(moves, x, y, isWhite, *this, captureOnly);
+        break;
+    case PieceType::King:
+        King::possibleMoves(moves, x, y, isWhite, *this, captureOnly);
+        break;
+    case PieceType::Knight:
+        Knight::possibleMoves(moves, x, y, isWhite, *this, captureOnly);
+        break;
+    case PieceType::Pawn:
+        Pawn::possibleMoves(moves, x, y, isWhite, *this, captureOnly);
+        break;
+    case PieceType::Queen:
+        Queen::possibleMoves(moves, x, y, isWhite, *this, captureOnly);
+        break;
+    case PieceType::Rook:
+        Rook::possibleMoves(moves, x, y, isWhite, *this, captureOnly);
+        break;
     }
+}
 
-    newGameStates.reserve(moves.size());
-    for (char i = 0; i < moves.size(); i++) {
-        newGameStates.emplace_back(*this);
-        newGameStates.back().applyMove(moves[i]);
-
-        if (newGameStates.back().isCheck(_isWhiteSideToMove)) {
-            newGameStates.pop_back();
-        }
+void GameState::pseudoLegalMoves(MoveList& moves, bool captureOnly) const {
+    // Generate the moves of all pieces of the side to move
+    uint64_t pieces = colorBitboard(_isWhiteSideToMove);
+    while (pieces) {
+        int square = popLeastSignificantSquare(pieces);
+        possibleMoves(moves, square % 8, square / 8, captureOnly);
     }
-    
 }
 
-bool GameState::isCheck(bool isWhite) const {
-	if (isWhite) {
-        return isThreatened(isWhite, _whiteKingX, _whiteKingY);
-	}
+void GameState::legalMoves(MoveList& moves, bool captureOnly) const {
+    int firstMove = moves.size();
+    pseudoLegalMoves(moves, captureOnly);
 
-    return isThreatened(isWhite, _blackKingX, _blackKingY);
+    // Remove the moves that would leave the king of the side to move in check
+    LegalityMasks masks = legalityMasks();
+    int legalMoveCount = firstMove;
+    for (int i = firstMove; i < moves.size(); i++) {
+        if (isLegal(moves[i], masks)) {
+            moves[legalMoveCount++] = moves[i];
+        }
+    }
+    moves.resize(legalMoveCount);
 }
 
-bool GameState::isThreatened(bool isWhite, char x, char y) const {
-    // Check for rooks and queens at the right side of the square
-    for (char i = x + 1; i < 8; i++) {
-        if (_board[y][i] == 0)
-            continue;
-        if (_board[y][i]->isWhite() == isWhite)
-            break;
-		if (_board[y][i]->getType() != PieceType::Rook && _board[y][i]->getType() != PieceType::Queen)
-			break;
+bool GameState::isPseudoLegal(const Move& move) const {
+    // The move must be one of the moves of a piece of the side to move at the start square
+    int piece = pieceIndexAt(move.fromSquare());
+    if (piece == -1 || isWhitePiece(piece) != _isWhiteSideToMove)
+        return false;
 
-        return true;
+    MoveList pieceMoves;
+    possibleMoves(pieceMoves, move.x1(), move.y1());
+    for (const Move& pieceMove : pieceMoves) {
+        if (pieceMove == move)
+            return true;
     }
 
-    // Check for rooks and queens at the left side of the square
-    for (char i = x - 1; i > -1; i--) {
-        if (_board[y][i] == 0)
-            continue;
-        if (_board[y][i]->isWhite() == isWhite)
-            break;
-        if (_board[y][i]->getType() != PieceType::Rook && _board[y][i]->getType() != PieceType::Queen)
-            break;
+    return false;
+}
 
-        return true;
+LegalityMasks GameState::legalityMasks() const {
+    LegalityMasks masks;
+    bool isWhite = _isWhiteSideToMove;
+    uint64_t occupied = occupiedBitboard();
+    uint64_t opponentPieces = colorBitboard(!isWhite);
+    masks.kingSquare = leastSignificantSquare(pieceBitboard(PieceType::King, isWhite));
+
+    // The checking pieces and the squares that block or capture a single checker
+    masks.checkers = attackersTo(masks.kingSquare, occupied) & opponentPieces;
+    if (masks.checkers == 0) {
+        masks.checkMask = ~0ULL;
+    }
+    else if ((masks.checkers & (masks.checkers - 1)) == 0) {
+        masks.checkMask = masks.checkers | Bitboards::betweenSquares(masks.kingSquare, leastSignificantSquare(masks.checkers));
+    }
+
+    // A piece is pinned if it is the only piece between the king and an opponent's sliding piece attacking along the line
+    uint64_t straightSliders = (_pieceTypeBitboards[static_cast<int>(PieceType::Rook)] | _pieceTypeBitboards[static_cast<int>(PieceType::Queen)]) & opponentPieces;
+    uint64_t diagonalSliders = (_pieceTypeBitboards[static_cast<int>(PieceType::Bishop)] | _pieceTypeBitboards[static_cast<int>(PieceType::Queen)]) & opponentPieces;
+    uint64_t pinners = (Bitboards::rookAttacks(masks.kingSquare, 0) & straightSliders) | (Bitboards::bishopAttacks(masks.kingSquare, 0) & diagonalSliders);
+    while (pinners) {
+        uint64_t blockers = Bitboards::betweenSquares(masks.kingSquare, popLeastSignificantSquare(pinners)) & occupied;
+        if (blockers && (blockers & (blockers - 1)) == 0) {
+            masks.pinnedPieces |= blockers & colorBitboard(isWhite);
+        }
     }
 
-    // Check for rooks and queens at the down side of the square
-    for (char i = y + 1; i < 8; i++) {
-        if (_board[i][x] == 0)
-            continue;
-        if (_board[i][x]->isWhite() == isWhite)
-            break;
-        if (_board[i][x]->getType() != PieceType::Rook && _board[i][x]->getType() != PieceType::Queen)
-            break;
+    return masks;
+}
 
-        return true;
+bool GameState::isLegal(const Move& move, const LegalityMasks& masks) const {
+    bool isWhite = _isWhiteSideToMove;
+    int fromSquare = squareIndex(move.x1(), move.y1());
+    int toSquare = squareIndex(move.x2(), move.y2());
+    uint64_t opponentPieces = colorBitboard(!isWhite);
+
+    // The king must not move to an attacked square (the king doesn't block the attacks along the lines it moves)
+    // Castling is legal, as the king moves are generated only when the king and the passed squares are not threatened
+    if (fromSquare == masks.kingSquare) {
+        if (move.isCastling())
+            return true;
+        return (attackersTo(toSquare, occupiedBitboard() ^ squareBitboard(fromSquare)) & opponentPieces) == 0;
     }
 
-    // Check for rooks and queens at the up side of the square
-    for (char i = y - 1; i > -1; i--) {
-        if (_board[i][x] == 0)
-            continue;
-        if (_board[i][x]->isWhite() == isWhite)
-            break;
-        if (_board[i][x]->getType() != PieceType::Rook && _board[i][x]->getType() != PieceType::Queen)
-            break;
+    // The other pieces must block or capture the checking piece and stay on the pinning line
+    if (!(masks.checkMask & squareBitboard(toSquare)) && !move.isEnPassant())
+        return false;
+    if ((masks.pinnedPieces & squareBitboard(fromSquare)) && !(Bitboards::lineSquares(masks.kingSquare, fromSquare) & squareBitboard(toSquare)))
+        return false;
 
-        return true;
+    // En passant removes two pieces from the lines of the king, so check the attacks with the board after the move
+    if (move.isEnPassant()) {
+        int capturedSquare = squareIndex(move.x2(), move.y1());
+        uint64_t occupied = (occupiedBitboard() ^ squareBitboard(fromSquare) ^ squareBitboard(capturedSquare)) | squareBitboard(toSquare);
+        return (attackersTo(masks.kingSquare, occupied) & opponentPieces & ~squareBitboard(capturedSquare)) == 0;
     }
 
-	// Check for bishops and queens at the lower right side of the square
-    char j = y;
-    for (char i = x + 1; i < 8; i++) {
-        j++;
-		if (j > 7)
-			break;
+    return true;
+}
 
-        if (_board[j][i] == 0)
-            continue;
-        if (_board[j][i]->isWhite() == isWhite)
-            break;
-        if (_board[j][i]->getType() != PieceType::Bishop && _board[j][i]->getType() != PieceType::Queen)
+int GameState::staticExchangeEvaluation(const Move& move) const {
+    int fromSquare = move.fromSquare();
+    int toSquare = move.toSquare();
+    uint64_t occupied = occupiedBitboard() ^ squareBitboard(fromSquare);
+
+    // The material won with each capture of the exchange if the exchange stopped after it
+    int gains[32];
+    int capturedPiece = pieceIndexAt(toSquare);
+    gains[0] = capturedPiece == -1 ? 0 : STATIC_EXCHANGE_PIECE_VALUES[capturedPiece % 6];
+    if (move.isEnPassant()) {
+        gains[0] = STATIC_EXCHANGE_PIECE_VALUES[static_cast<int>(PieceType::Pawn)];
+        occupied ^= squareBitboard(squareIndex(move.x2(), move.y1()));
+    }
+
+    // The value of the piece standing on the target square, which the next capture of the exchange takes
+    int pieceValue = STATIC_EXCHANGE_PIECE_VALUES[pieceIndexAt(fromSquare) % 6];
+    if (move.isPromotion()) {
+        const PieceType promotionTypes[4] = { PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen };
+        pieceValue = STATIC_EXCHANGE_PIECE_VALUES[static_cast<int>(promotionTypes[move.flags() & 3])];
+        gains[0] += pieceValue - STATIC_EXCHANGE_PIECE_VALUES[static_cast<int>(PieceType::Pawn)];
+    }
+
+    // The least valuable piece types first
+    const PieceType attackerOrder[6] = { PieceType::Pawn, PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen, PieceType::King };
+
+    int depth = 0;
+    bool isWhite = !_isWhiteSideToMove;
+    while (depth < 31) {
+        // The attackers are recalculated with the captured pieces removed, which reveals the x-ray attackers
+        uint64_t attackers = attackersTo(toSquare, occupied) & occupied & colorBitboard(isWhite);
+        if (!attackers)
             break;
 
-        return true;
-    }
+        // Recapture with the least valuable attacker
+        int attackerType = 0;
+        uint64_t attacker = 0;
+        for (PieceType type : attackerOrder) {
+            attacker = attackers & _pieceTypeBitboards[static_cast<int>(type)];
+            if (attacker) {
+                attackerType = static_cast<int>(type);
+                break;
+            }
+        }
 
-    // Check for bishops and queens at the upper right side of the square
-    j = y;
-    for (char i = x + 1; i < 8; i++) {
-        j--;
-        if (j < 0)
-            break;
+        depth++;
+        gains[depth] = pieceValue - gains[depth - 1];
 
-        if (_board[j][i] == 0)
-            continue;
-        if (_board[j][i]->isWhite() == isWhite)
-            break;
-        if (_board[j][i]->getType() != PieceType::Bishop && _board[j][i]->getType() != PieceType::Queen)
+        // Stop if the exchange can't become better for the recapturing side
+        if (std::max(-gains[depth - 1], gains[depth]) < 0)
             break;
 
-        return true;
+        occupied ^= squareBitboard(leastSignificantSquare(attacker));
+        pieceValue = STATIC_EXCHANGE_PIECE_VALUES[attackerType];
+        isWhite = !isWhite;
     }
 
-    // Check for bishops and queens at the lower left side of the square
-    j = y;
-    for (char i = x - 1; i > -1; i--) {
-        j++;
-        if (j > 7)
-            break;
+    // Each side stops the exchange when continuing it would be worse than stopping
+    while (depth > 0) {
+        gains[depth - 1] = -std::max(-gains[depth - 1], gains[depth]);
+        depth--;
+    }
 
-        if (_board[j][i] == 0)
-            continue;
-        if (_board[j][i]->isWhite() == isWhite)
-            break;
-        if (_board[j][i]->getType() != PieceType::Bishop && _board[j][i]->getType() != PieceType::Queen)
-            break;
+    return gains[0];
+}
 
-        return true;
-    }
+uint64_t GameState::attackersTo(int square, uint64_t occupancy) const {
+    uint64_t straightSliders = _pieceTypeBitboards[static_cast<int>(PieceType::Rook)] | _pieceTypeBitboards[static_cast<int>(PieceType::Queen)];
+    uint64_t diagonalSliders = _pieceTypeBitboards[static_cast<int>(PieceType::Bishop)] | _pieceTypeBitboards[static_cast<int>(PieceType::Queen)];
+    uint64_t pawns = _pieceTypeBitboards[static_cast<int>(PieceType::Pawn)];
+
+    // The pawns attack the square from the squares a pawn of the other color would attack
+    return (Bitboards::knightAttacks(square) & _pieceTypeBitboards[static_cast<int>(PieceType::Knight)])
+        | (Bitboards::kingAttacks(square) & _pieceTypeBitboards[static_cast<int>(PieceType::King)])
+        | (Bitboards::pawnAttacks(true, square) & pawns & _colorBitboards[1])
+        | (Bitboards::pawnAttacks(false, square) & pawns & _colorBitboards[0])
+        | (Bitboards::rookAttacks(square, occupancy) & straightSliders)
+        | (Bitboards::bishopAttacks(square, occupancy) & diagonalSliders);
+}
 
-    // Check for bishops and queens at the upper left side of the square
-    j = y;
-    for (char i = x - 1; i > -1; i--) {
-        j--;
-        if (j < 0)
-            break;
+bool GameState::isCheck(bool isWhite) const {
+    int kingSquare = leastSignificantSquare(pieceBitboard(PieceType::King, isWhite));
+    return isThreatened(isWhite, kingSquare % 8, kingSquare / 8);
+}
 
-        if (_board[j][i] == 0)
-            continue;
-        if (_board[j][i]->isWhite() == isWhite)
-            break;
-        if (_board[j][i]->getType() != PieceType::Bishop && _board[j][i]->getType() != PieceType::Queen)
-            break;
+bool GameState::isThreatened(bool isWhite, char x, char y) const {
+    int square = squareIndex(x, y);
+    uint64_t opponentPieces = colorBitboard(!isWhite);
 
+    // Check for knights
+    if (Bitboards::knightAttacks(square) & _pieceTypeBitboards[static_cast<int>(PieceType::Knight)] & opponentPieces)
         return true;
-    }
 
-	// Check for knights
-	if (x - 2 > -1 && y - 1 > -1 && _board[y - 1][x - 2] != 0 && _board[y - 1][x - 2]->isWhite() != isWhite && _board[y - 1][x - 2]->getType() == PieceType::Knight) {
-		return true;
-	}
-    if (x - 1 > -1 && y - 2 > -1 && _board[y - 2][x - 1] != 0 && _board[y - 2][x - 1]->isWhite() != isWhite && _board[y - 2][x - 1]->getType() == PieceType::Knight) {
-        return true;
-    }
-    if (x + 1 < 8 && y - 2 > -1 && _board[y - 2][x + 1] != 0 && _board[y - 2][x + 1]->isWhite() != isWhite && _board[y - 2][x + 1]->getType() == PieceType::Knight) {
+    // Check for kings
+    if (Bitboards::kingAttacks(square) & _pieceTypeBitboards[static_cast<int>(PieceType::King)] & opponentPieces)
         return true;
-    }
-    if (x + 2 < 8 && y - 1 > -1 && _board[y - 1][x + 2] != 0 && _board[y - 1][x + 2]->isWhite() != isWhite && _board[y - 1][x + 2]->getType() == PieceType::Knight) {
-        return true;
-    }
-    if (x + 2 < 8 && y + 1 < 8 && _board[y + 1][x + 2] != 0 && _board[y + 1][x + 2]->isWhite() != isWhite && _board[y + 1][x + 2]->getType() == PieceType::Knight) {
-        return true;
-    }
-    if (x + 1 < 8 && y + 2 < 8 && _board[y + 2][x + 1] != 0 && _board[y + 2][x + 1]->isWhite() != isWhite && _board[y + 2][x + 1]->getType() == PieceType::Knight) {
-        return true;
-    }
-    if (x - 1 > -1 && y + 2 < 8 && _board[y + 2][x - 1] != 0 && _board[y + 2][x - 1]->isWhite() != isWhite && _board[y + 2][x - 1]->getType() == PieceType::Knight) {
-        return true;
-    }
-    if (x - 2 > -1 && y + 1 < 8 && _board[y + 1][x - 2] != 0 && _board[y + 1][x - 2]->isWhite() != isWhite && _board[y + 1][x - 2]->getType() == PieceType::Knight) {
-        return true;
-    }
-
-	// Check for kings
-    for (char i = x - 1; i <= x + 1; i++) {
-		if (i < 0 || i > 7)
-			continue;
-
-        for (char j = y - 1; j <= y + 1; j++) {
-            if (j < 0 || j > 7)
-                continue;
-			if (i == x && j == y)
-				continue;
 
-			if (_board[j][i] == 0)
-				continue;
-			if (_board[j][i]->isWhite() == isWhite)
-				continue;
-			if (_board[j][i]->getType() != PieceType::King)
-				continue;
+    // Check for pawns (the opponent's pawns threaten the square from the squares a pawn of the given color would attack)
+    if (Bitboards::pawnAttacks(isWhite, square) & _pieceTypeBitboards[static_cast<int>(PieceType::Pawn)] & opponentPieces)
+        return true;
 
-			return true;
-        }
-    }
+    // Check for rooks and queens at the straight lines of the square
+    uint64_t straightSliders = (_pieceTypeBitboards[static_cast<int>(PieceType::Rook)] | _pieceTypeBitboards[static_cast<int>(PieceType::Queen)]) & opponentPieces;
+    if (straightSliders && (Bitboards::rookAttacks(square, occupiedBitboard()) & straightSliders))
+        return true;
 
-	// Check for pawns
-    if (isWhite) {
-		if (x - 1 > -1 && y - 1 > -1 && _board[y - 1][x - 1] != 0 && _board[y - 1][x - 1]->isWhite() != isWhite && _board[y - 1][x - 1]->getType() == PieceType::Pawn) {
-			return true;
-		}
-		if (x + 1 < 8 && y - 1 > -1 && _board[y - 1][x + 1] != 0 && _board[y - 1][x + 1]->isWhite() != isWhite && _board[y - 1][x + 1]->getType() == PieceType::Pawn) {
-			return true;
-		}
-	}
-	else {
-		if (x - 1 > -1 && y + 1 < 8 && _board[y + 1][x - 1] != 0 && _board[y + 1][x - 1]->isWhite() != isWhite && _board[y + 1][x - 1]->getType() == PieceType::Pawn) {
-			return true;
-		}
-		if (x + 1 < 8 && y + 1 < 8 && _board[y + 1][x + 1] != 0 && _board[y + 1][x + 1]->isWhite() != isWhite && _board[y + 1][x + 1]->getType() == PieceType::Pawn) {
-			return true;
-		}
-    }
+    // Check for bishops and queens at the diagonal lines of the square
+    uint64_t diagonalSliders = (_pieceTypeBitboards[static_cast<int>(PieceType::Bishop)] | _pieceTypeBitboards[static_cast<int>(PieceType::Queen)]) & opponentPieces;
+    if (diagonalSliders && (Bitboards::bishopAttacks(square, occupiedBitboard()) & diagonalSliders))
+        return true;
 
     return false;
 }
@@ -580,6 +806,18 @@ int GameState::evaluationValue(bool isWhite) const {
     return isWhite ? _evaluationValue : -_evaluationValue;
 }
 
+uint64_t GameState::pieceBitboard(PieceType type, bool isWhite) const {
+    return _pieceTypeBitboards[static_cast<int>(type)] & _colorBitboards[isWhite ? 0 : 1];
+}
+
+uint64_t GameState::colorBitboard(bool isWhite) const {
+    return _colorBitboards[isWhite ? 0 : 1];
+}
+
+uint64_t GameState::occupiedBitboard() const {
+    return _colorBitboards[0] | _colorBitboards[1];
+}
+
 bool GameState::isWhiteSideToMove() const {
     return _isWhiteSideToMove;
 }
@@ -1,42 +1,121 @@
 #ifndef GAMESTATE_H
 #define GAMESTATE_H
 
-#include <vector>
+#include <cstdint>
+#include <string>
 #include "../move.h"
+#include "../moveList.h"
+#include "../piece.h"
 
-class Piece;
-class King;
+/// <summary>
+/// Describes the information that is needed to undo a move made with GameState::makeMove
+/// or a null move made with GameState::makeNullMove.
+/// </summary>
+struct UndoRecord {
+	/// <summary>
+	/// The last move of the game state before the move was made.
+	/// </summary>
+	Move lastMove = Move(0, 0, 0, 0);
+
+	/// <summary>
+	/// The hash of the game state before the move was made.
+	/// </summary>
+	uint64_t hash = 0;
+
+	/// <summary>
+	/// The evaluation value of the game state before the move was made.
+	/// </summary>
+	int evaluationValue = 0;
+
+	/// <summary>
+	/// The piece index (see pieceIndex()) of the captured piece, or -1 if the move didn't capture.
+	/// </summary>
+	char capturedPiece = -1;
+
+	/// <summary>
+	/// The square index of the captured piece (differs from the move target square in en passant moves).
+	/// </summary>
+	char capturedSquare = -1;
+
+	/// <summary>
+	/// The game phase value of the game state before the move was made.
+	/// </summary>
+	char gamePhase = 0;
+
+	/// <summary>
+	/// The upper en passant column before the move was made.
+	/// </summary>
+	char upperEnPassantColumn = -1;
+
+	/// <summary>
+	/// The lower en passant column before the move was made.
+	/// </summary>
+	char lowerEnPassantColumn = -1;
+
+	/// <summary>
+	/// The upper left castling flag before the move was made.
+	/// </summary>
+	bool upperLeftCastlingPossible = true;
+
+	/// <summary>
+	/// The upper right castling flag before the move was made.
+	/// </summary>
+	bool upperRightCastlingPossible = true;
+
+	/// <summary>
+	/// The lower left castling flag before the move was made.
+	/// </summary>
+	bool lowerLeftCastlingPossible = true;
+
+	/// <summary>
+	/// The lower right castling flag before the move was made.
+	/// </summary>
+	bool lowerRightCastlingPossible = true;
+};
 
 /// <summary>
-/// Describes a game state.
+/// Describes the check and pin information of the side to move of a game state.
+/// Used to check the legality of pseudo-legal moves without making them (see GameState::isLegal).
 /// </summary>
-class GameState {
+struct LegalityMasks {
+	/// <summary>
+	/// The square index of the king of the side to move.
+	/// </summary>
+	int kingSquare = 0;
 
-private:
 	/// <summary>
-	/// The current board content.
+	/// The opponent's pieces that give check to the king of the side to move.
 	/// </summary>
-	Piece* _board[8][8];
+	uint64_t checkers = 0;
 
 	/// <summary>
-	/// The white king's X coordinate.
+	/// The squares other pieces than the king can move to: all squares when the king is not in check,
+	/// the checking piece and the squares between it and the king in a single check, and no squares in a double check.
 	/// </summary>
-	char _whiteKingX = 4;
+	uint64_t checkMask = 0;
 
 	/// <summary>
-	/// The white king's Y coordinate.
+	/// The pieces of the side to move that are pinned to their king. A pinned piece can only move along the pinning line.
 	/// </summary>
-	char _whiteKingY = 7;
+	uint64_t pinnedPieces = 0;
+};
+
+/// <summary>
+/// Describes a game state.
+/// </summary>
+class GameState {
 
+private:
 	/// <summary>
-	/// The black king's X coordinate.
+	/// The bitboards of the pieces of each piece type (indexed with PieceType) regardless of color.
+	/// Bit n of a bitboard describes the square at X coordinate n % 8 and Y coordinate n / 8.
 	/// </summary>
-	char _blackKingX = 4;
+	uint64_t _pieceTypeBitboards[6];
 
 	/// <summary>
-	/// The black king's Y coordinate.
+	/// The bitboards of all pieces of each color (index 0 = white, 1 = black).
 	/// </summary>
-	char _blackKingY = 0;
+	uint64_t _colorBitboards[2];
 
 	/// <summary>
 	/// The evaluation value of this game state for white.
@@ -97,6 +176,65 @@ private:
 	/// </summary>
 	uint64_t _hash = 0;
 
+	/// <summary>
+	/// Returns the piece index (see pieceIndex()) of the piece at the given square index.
+	/// </summary>
+	/// <param name="square">The square index</param>
+	/// <returns>The piece index, or -1 if the square is empty</returns>
+	int pieceIndexAt(int square) const;
+
+	/// <summary>
+	/// Adds the piece of the given piece index to the given empty square.
+	/// Updates the hash, game phase and evaluation value.
+	/// </summary>
+	/// <param name="pieceIndex">The piece index</param>
+	/// <param name="square">The square index</param>
+	void putPiece(int pieceIndex, int square);
+
+	/// <summary>
+	/// Removes the piece of the given piece index from the given square.
+	/// Updates the hash, game phase and evaluation value.
+	/// </summary>
+	/// <param name="pieceIndex">The piece index</param>
+	/// <param name="square">The square index</param>
+	void removePiece(int pieceIndex, int square);
+
+	/// <summary>
+	/// Moves the piece of the given piece index from the given square to the given empty square.
+	/// Updates the hash and evaluation value.
+	/// </summary>
+	/// <param name="pieceIndex">The piece index</param>
+	/// <param name="fromSquare">The square index the piece is moved from</param>
+	/// <param name="toSquare">The square index the piece is moved to</param>
+	void movePiece(int pieceIndex, int fromSquare, int toSquare);
+
+	/// <summary>
+	/// Toggles the given square of the piece of the given piece index in the bitboards.
+	/// Doesn't update the hash, game phase or evaluation value.
+	/// </summary>
+	/// <param name="pieceIndex">The piece index</param>
+	/// <param name="square">The square index</param>
+	void toggleSquare(int pieceIndex, int square);
+
+	/// <summary>
+	/// Saves the values that moves change to the given undo record.
+	/// </summary>
+	/// <param name="undo">The undo record to save the values to</param>
+	void saveUndoRecord(UndoRecord& undo) const;
+
+	/// <summary>
+	/// Restores the values that moves change from the given undo record.
+	/// Doesn't restore the bitboards.
+	/// </summary>
+	/// <param name="undo">The undo record to restore the values from</param>
+	void restoreUndoRecord(const UndoRecord& undo);
+
+	/// <summary>
+	/// Calculates the game phase, hash and evaluation value from the bitboards, castling flags,
+	/// en passant columns and side to move.
+	/// </summary>
+	void calculateDerivedValues();
+
 public:
 	/// <summary>
 	/// Compares the other game state with this game state.
@@ -113,10 +251,28 @@ public:
 	bool operator!=(const GameState& other) const;
 
 	/// <summary>
-	/// Creates a new GameState with empty board.
+	/// Creates a new GameState with the pieces at their starting positions.
 	/// </summary>
 	GameState();
 
+	/// <summary>
+	/// Sets the given game state to the position described by the given FEN string.
+	/// The halfmove clock and fullmove number fields are optional and ignored, as game states don't track them.
+	/// The game state is not changed if the FEN string is not valid. Positions without exactly one king of each side
+	/// and positions where the side that is not to move is in check are not valid.
+	/// </summary>
+	/// <param name="fen">The FEN string</param>
+	/// <param name="state">The game state to set</param>
+	/// <returns>True if the FEN string was valid and the game state was set</returns>
+	static bool fromFEN(const std::string& fen, GameState& state);
+
+	/// <summary>
+	/// Converts the game state to a FEN string. The halfmove clock and fullmove number are written as 0 and 1,
+	/// as game states don't track them.
+	/// </summary>
+	/// <returns>The FEN string</returns>
+	std::string toFEN() const;
+
 	/// <summary>
 	/// Moves the given move. Handles capture if the move moves a piece to a place where another piece is located.
 	/// Updates the castling and en passant flags automatically. Handles castling and en passant moves automatically.
@@ -126,32 +282,122 @@ public:
 	/// <param name="move">The move to apply</param>
 	void applyMove(const Move& move);
 
+	/// <summary>
+	/// Moves the given move like applyMove and saves the information needed to undo the move to the given undo record.
+	/// The move can be undone with unmakeMove by giving the same undo record.
+	/// Does not check if the move is valid!
+	/// </summary>
+	/// <param name="move">The move to make</param>
+	/// <param name="undo">The undo record where the undo information is saved</param>
+	void makeMove(const Move& move, UndoRecord& undo);
+
+	/// <summary>
+	/// Undoes the last move made with makeMove. The undo record must be the one given to makeMove.
+	/// </summary>
+	/// <param name="undo">The undo record of the move</param>
+	void unmakeMove(const UndoRecord& undo);
+
+	/// <summary>
+	/// Passes the turn to the other side without moving any piece.
+	/// Clears the en passant flags as en passant is only possible right after the double move.
+	/// </summary>
 	void applyNullMove();
 
+	/// <summary>
+	/// Makes a null move like applyNullMove and saves the information needed to undo it to the given undo record.
+	/// </summary>
+	/// <param name="undo">The undo record where the undo information is saved</param>
+	void makeNullMove(UndoRecord& undo);
+
+	/// <summary>
+	/// Undoes the last null move made with makeNullMove. The undo record must be the one given to makeNullMove.
+	/// </summary>
+	/// <param name="undo">The undo record of the null move</param>
+	void unmakeNullMove(const UndoRecord& undo);
+
 	/// <summary>
 	/// Prints the board content to the console.
 	/// </summary>
 	void printBoard() const;
 
 	/// <summary>
-	/// Returns the piece at the given coordinates.
+	/// Returns the piece index (see pieceIndex()) of the piece at the given coordinates.
 	/// The coordinates are given as internal index coordinates!
 	/// Does not check if the coordinates are valid!
 	/// </summary>
 	/// <param name="x">The x coordinate of the piece</param>
 	/// <param name="y">The y coordinate of the piece</param>
-	/// <returns>The piece at the given coordinates.</returns>
-	Piece* getPieceAt(char x, char y) const;
+	/// <returns>The piece index, or -1 if the square is empty</returns>
+	int getPieceAt(char x, char y) const;
 
 	/// <summary>
-	/// Adds all possible new game states that can be created from this game state with
-	/// one move to the newGameStates vector. The game states are fully validated to not
-	/// contain moves that would put the king of the given color in check.
+	/// Adds the possible moves of the piece at the given coordinates to the move list.
+	/// Does not take into account if the king is threatened.
 	/// You can generate only capture moves by setting the captureOnly parameter to true.
 	/// </summary>
-	/// <param name="gameStates">The vector where the new game states will be added</param>
+	/// <param name="moves">The move list where the moves will be added</param>
+	/// <param name="x">The x coordinate of the piece</param>
+	/// <param name="y">The y coordinate of the piece</param>
 	/// <param name="captureOnly">If to generate only capture moves</param>
-	void possibleNewGameStates(std::vector<GameState>& gameStates, bool captureOnly = false) const;
+	void possibleMoves(MoveList& moves, char x, char y, bool captureOnly = false) const;
+
+	/// <summary>
+	/// Adds all legal moves of the side to move to the move list. The moves are fully validated
+	/// to not put the king of the side to move in check.
+	/// You can generate only capture moves by setting the captureOnly parameter to true.
+	/// </summary>
+	/// <param name="moves">The move list where the moves will be added</param>
+	/// <param name="captureOnly">If to generate only capture moves</param>
+	void legalMoves(MoveList& moves, bool captureOnly = false) const;
+
+	/// <summary>
+	/// Adds all pseudo-legal moves of the side to move to the move list. The moves are not validated
+	/// to not put the king of the side to move in check, so their legality must be checked with isLegal before they are made.
+	/// You can generate only capture moves by setting the captureOnly parameter to true.
+	/// </summary>
+	/// <param name="moves">The move list where the moves will be added</param>
+	/// <param name="captureOnly">If to generate only capture moves</param>
+	void pseudoLegalMoves(MoveList& moves, bool captureOnly = false) const;
+
+	/// <summary>
+	/// Checks if the given move is a pseudo-legal move of the side to move (a move pseudoLegalMoves would generate).
+	/// Used to validate moves from other sources, like the transposition table, before making them.
+	/// </summary>
+	/// <param name="move">The move to check</param>
+	/// <returns>True if the move is pseudo-legal</returns>
+	bool isPseudoLegal(const Move& move) const;
+
+	/// <summary>
+	/// Calculates the check and pin information of the side to move for checking the legality of moves with isLegal.
+	/// </summary>
+	/// <returns>The legality masks of the side to move</returns>
+	LegalityMasks legalityMasks() const;
+
+	/// <summary>
+	/// Checks if the pseudo-legal move of the side to move is legal (does not leave the king of the side to move in check).
+	/// The move must have been generated by pseudoLegalMoves for this game state.
+	/// </summary>
+	/// <param name="move">The pseudo-legal move</param>
+	/// <param name="masks">The legality masks of this game state calculated with legalityMasks</param>
+	/// <returns>True if the move is legal</returns>
+	bool isLegal(const Move& move, const LegalityMasks& masks) const;
+
+	/// <summary>
+	/// Calculates the material balance of the exchange the given capture starts on its target square
+	/// when both sides recapture with their least valuable attackers and stop when recapturing would lose material.
+	/// The attackers behind other attackers on the same line (x-rays) are taken into account.
+	/// </summary>
+	/// <param name="move">The pseudo-legal capture of the side to move</param>
+	/// <returns>The material the side to move wins with the exchange (negative if it loses material)</returns>
+	int staticExchangeEvaluation(const Move& move) const;
+
+	/// <summary>
+	/// The pieces of both colors that attack the given square when the given squares are occupied.
+	/// </summary>
+	/// <param name="square">The square index</param>
+	/// <param name="occupancy">The occupied squares, which block the sliding pieces</param>
+	/// <returns>The bitboard of the attacking pieces</returns>
+	uint64_t attackersTo(int square, uint64_t occupancy) const;
 
 	/// <summary>
 	/// Checks if the king of the given color is in check.
@@ -178,6 +424,27 @@ public:
 	/// <returns>The evaluation value</returns>
 	int evaluationValue(bool isWhite) const;
 
+	/// <summary>
+	/// The bitboard of the pieces of the given type and color.
+	/// </summary>
+	/// <param name="type">The piece type</param>
+	/// <param name="isWhite">If to get the white pieces</param>
+	/// <returns>The bitboard of the pieces</returns>
+	uint64_t pieceBitboard(PieceType type, bool isWhite) const;
+
+	/// <summary>
+	/// The bitboard of all pieces of the given color.
+	/// </summary>
+	/// <param name="isWhite">If to get the white pieces</param>
+	/// <returns>The bitboard of the pieces</returns>
+	uint64_t colorBitboard(bool isWhite) const;
+
+	/// <summary>
+	/// The bitboard of all occupied squares.
+	/// </summary>
+	/// <returns>The bitboard of the occupied squares</returns>
+	uint64_t occupiedBitboard() const;
+
 	/// <summary>
 	/// Checks if the side to move is white.
 	/// </summary>
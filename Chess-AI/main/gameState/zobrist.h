@@ -0,0 +1,104 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstdint>
+
+/// <summary>
+/// The seed the zobrist hashing values are generated from. The values are the same in every build and run,
+/// so hash values can be compared between processes and stored to files.
+/// </summary>
+constexpr uint64_t ZOBRIST_SEED = 0x43686573734149ULL;
+
+/// <summary>
+/// All zobrist hashing values of the game state hash.
+/// </summary>
+struct ZobristValues {
+	/// <summary>
+	/// Zobrist hashing values for the pieces (indexed with the piece index) at the squares (indexed with the square index).
+	/// </summary>
+	uint64_t pieces[12][64];
+
+	/// <summary>
+	/// Zobrist hashing value to be used if the side to move is white.
+	/// </summary>
+	uint64_t whiteSideToMove;
+
+	/// <summary>
+	/// Zobrist hashing value for upper left castling possibility.
+	/// </summary>
+	uint64_t upperLeftCastling;
+
+	/// <summary>
+	/// Zobrist hashing value for upper right castling possibility.
+	/// </summary>
+	uint64_t upperRightCastling;
+
+	/// <summary>
+	/// Zobrist hashing value for lower left castling possibility.
+	/// </summary>
+	uint64_t lowerLeftCastling;
+
+	/// <summary>
+	/// Zobrist hashing value for lower right castling possibility.
+	/// </summary>
+	uint64_t lowerRightCastling;
+
+	/// <summary>
+	/// Zobrist hashing values for upper en passant columns.
+	/// </summary>
+	uint64_t upperEnPassant[8];
+
+	/// <summary>
+	/// Zobrist hashing values for lower en passant columns.
+	/// </summary>
+	uint64_t lowerEnPassant[8];
+};
+
+/// <summary>
+/// Advances the given SplitMix64 generator state and returns the next pseudo-random number.
+/// </summary>
+/// <param name="state">The generator state</param>
+/// <returns>The pseudo-random number</returns>
+constexpr uint64_t splitMix64(uint64_t& state) {
+	state += 0x9E3779B97F4A7C15ULL;
+	uint64_t value = state;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+	return value ^ (value >> 31);
+}
+
+/// <summary>
+/// Generates the zobrist hashing values from ZOBRIST_SEED.
+/// </summary>
+/// <returns>The zobrist hashing values</returns>
+constexpr ZobristValues generateZobristValues() {
+	ZobristValues values{};
+	uint64_t state = ZOBRIST_SEED;
+
+	for (int piece = 0; piece < 12; piece++) {
+		for (int square = 0; square < 64; square++) {
+			values.pieces[piece][square] = splitMix64(state);
+		}
+	}
+
+	values.whiteSideToMove = splitMix64(state);
+
+	values.upperLeftCastling = splitMix64(state);
+	values.upperRightCastling = splitMix64(state);
+	values.lowerLeftCastling = splitMix64(state);
+	values.lowerRightCastling = splitMix64(state);
+
+	for (int i = 0; i < 8; i++) {
+		values.upperEnPassant[i] = splitMix64(state);
+		values.lowerEnPassant[i] = splitMix64(state);
+	}
+
+	return values;
+}
+
+/// <summary>
+/// The zobrist hashing values, generated at compile time.
+/// </summary>
+constexpr ZobristValues ZOBRIST_VALUES = generateZobristValues();
+
+#endif
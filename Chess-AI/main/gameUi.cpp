@@ -8,14 +8,9 @@
 #include "raylib.h"
 
 #include "gameState/gameState.h"
-#include "gameState/gameInfo.h"
 #include "move.h"
-#include "pieces/bishop.h"
-#include "pieces/king.h"
-#include "pieces/knight.h"
-#include "pieces/pawn.h"
-#include "pieces/queen.h"
-#include "pieces/rook.h"
+#include "moveList.h"
+#include "piece.h"
 #include "chessAI.h"
 
 /// <summary>
@@ -32,33 +27,33 @@ void loadPieceTextures(std::unordered_map<std::string, Texture2D>& textures);
 /// </summary>
 /// <param name="gameState">The current game state</param>
 /// <param name="selectedSquare">The selected square coordinates</param>
-/// <param name="possibleMoves">The vector of possible moves</param>
+/// <param name="possibleMoves">The list of possible moves</param>
 /// <param name="previousStates">The stack of previous game states</param>
 /// <param name="nextStates">The stack of next game states</param>
 /// <param name="boardSize">The board width and height</param>
 /// <param name="boardOffsetX">The board X offset from the window 0 coordinate</param>
 /// <param name="boardOffsetY">The board Y offset from the window 0 coordinate</param>
-void handleInput(GameState& gameState, Vector2& selectedSquare, std::vector<Move>& possibleMoves, 
+void handleInput(GameState& gameState, Vector2& selectedSquare, MoveList& possibleMoves, 
     std::stack<GameState>& previousStates, std::stack<GameState>& nextStates, int boardSize, int boardOffsetX, int boardOffsetY, bool& isFlipped);
 
 /// <summary>
 /// Draws the board content to the window.
 /// </summary>
 /// <param name="gameState">The current game state</param>
-/// <param name="possibleMoves">The vector of possible moves</param>
+/// <param name="possibleMoves">The list of possible moves</param>
 /// <param name="selectedSquare">The selected square coordinates</param
 /// <param name="textures">Textures loaded with loadPieceTextures()</param>
 /// <param name="boardSize">The board width and height</param>
 /// <param name="boardOffsetX">The board X offset from the window 0 coordinate</param>
 /// <param name="boardOffsetY">The board Y offset from the window 0 coordinate</param>
 /// <param name="isFlipped">Whether the board is in flipped orientation</param>
-void drawBoard(const GameState& gameState, const std::vector<Move>& possibleMoves, const Vector2& selectedSquare,
+void drawBoard(const GameState& gameState, const MoveList& possibleMoves, const Vector2& selectedSquare,
     const std::unordered_map<std::string, Texture2D>& textures, int boardSize, int boardOffsetX, int boardOffsetY, bool isFlipped);
 
 /// <summary>
 /// Draws the given piece at the given coordinates to the window.
 /// </summary>
-/// <param name="piece">The piece to draw</param>
+/// <param name="piece">The piece index (see pieceIndex()) of the piece to draw, or -1 if there is no piece</param>
 /// <param name="x">The X coordinate of the piece</param>
 /// <param name="y">The Y coordinate of the piece</param>
 /// <param name="textures">Textures loaded with loadPieceTextures()</param>
@@ -66,7 +61,7 @@ void drawBoard(const GameState& gameState, const std::vector<Move>& possibleMove
 /// <param name="offsetX">The board X offset from the window 0 coordinate</param>
 /// <param name="offsetY">The board Y offset from the window 0 coordinate</param>
 /// <param name="isFlipped">Whether the board is in flipped orientation</param>
-void drawPiece(Piece* piece, int x, int y, const std::unordered_map<std::string, Texture2D>& textures, int squareSize, int offsetX, int offsetY, bool isFlipped);
+void drawPiece(int piece, int x, int y, const std::unordered_map<std::string, Texture2D>& textures, int squareSize, int offsetX, int offsetY, bool isFlipped);
 
 void startGameUi()
 {
@@ -76,13 +71,12 @@ void startGameUi()
     SetTargetFPS(60);
     MaximizeWindow();
 
-    // The game info and current game state
-    GameInfo gameInfo;
+    // The current game state
     GameState gameState;
 
     // The selected square, possible moves
     Vector2 selectedSquare = { -1, -1 };
-    std::vector<Move> possibleMoves;
+    MoveList possibleMoves;
 
     // The stacks of previous and next game states stack for the undo and redo features
 	std::stack<GameState> previousStates;
@@ -138,7 +132,7 @@ void loadPieceTextures(std::unordered_map<std::string, Texture2D>& textures) {
     textures["KB"] = LoadTexture("main/resources/black_king.png");
 }
 
-void handleInput(GameState& gameState, Vector2& selectedSquare, std::vector<Move>& possibleMoves, 
+void handleInput(GameState& gameState, Vector2& selectedSquare, MoveList& possibleMoves, 
     std::stack<GameState>& previousStates, std::stack<GameState>& nextStates, int boardSize, int boardOffsetX, int boardOffsetY, bool& isFlipped) {
     // Flip the board when pressing F key
     if (IsKeyPressed(KEY_F)) {
@@ -244,14 +238,14 @@ void handleInput(GameState& gameState, Vector2& selectedSquare, std::vector<Move
     // First click (select piece)
     if (selectedSquare.x == -1)
     {
-        Piece* selectedPiece = gameState.getPieceAt(file, rank);
-        if (selectedPiece)
+        int selectedPiece = gameState.getPieceAt(file, rank);
+        if (selectedPiece != -1)
         {
             selectedSquare = { (float)file, (float)rank };
 
             // There are no possible moves if moving piece at wrong turn
-            if (selectedPiece->isWhite() == gameState.isWhiteSideToMove()) {
-                selectedPiece->possibleMoves(possibleMoves, file, rank, gameState);
+            if (isWhitePiece(selectedPiece) == gameState.isWhiteSideToMove()) {
+                gameState.possibleMoves(possibleMoves, file, rank);
 
                 // Do not show moves that would lead the player to check
                 for (int i = 0; i < possibleMoves.size(); i++) {
@@ -270,8 +264,8 @@ void handleInput(GameState& gameState, Vector2& selectedSquare, std::vector<Move
     }
 
     // Second click (move the selected piece if possible)
-    Piece* movingPiece = gameState.getPieceAt(selectedSquare.x, selectedSquare.y);
-    if (movingPiece != 0 && movingPiece->isWhite() != gameState.isWhiteSideToMove()) {
+    int movingPiece = gameState.getPieceAt(selectedSquare.x, selectedSquare.y);
+    if (movingPiece != -1 && isWhitePiece(movingPiece) != gameState.isWhiteSideToMove()) {
         selectedSquare = { -1, -1 };
         possibleMoves.clear();
 
@@ -281,16 +275,16 @@ void handleInput(GameState& gameState, Vector2& selectedSquare, std::vector<Move
     Move move(selectedSquare.x, selectedSquare.y, file, rank);
 
     // Handle promotion
-    if (dynamic_cast<Pawn*>(movingPiece) != nullptr &&
-        ((movingPiece->isWhite() && rank == 0) ||
-            (!movingPiece->isWhite() && rank == 7)))
+    if (movingPiece != -1 && pieceTypeOf(movingPiece) == PieceType::Pawn &&
+        ((isWhitePiece(movingPiece) && rank == 0) ||
+            (!isWhitePiece(movingPiece) && rank == 7)))
     {
         bool isMovingStraight = (selectedSquare.x == file);
 
-        if ((movingPiece->isWhite() && selectedSquare.y == 1 && rank == 0) ||
-            (!movingPiece->isWhite() && selectedSquare.y == 6 && rank == 7))
+        if ((isWhitePiece(movingPiece) && selectedSquare.y == 1 && rank == 0) ||
+            (!isWhitePiece(movingPiece) && selectedSquare.y == 6 && rank == 7))
         {
-            if (!isMovingStraight || (isMovingStraight && gameState.getPieceAt(file, rank) == nullptr))
+            if (!isMovingStraight || (isMovingStraight && gameState.getPieceAt(file, rank) == -1))
             {
                 char promotion = 0;
                 int key = 0;
@@ -316,11 +310,12 @@ void handleInput(GameState& gameState, Vector2& selectedSquare, std::vector<Move
         }
     }
 
-    // Validate move
+    // Validate move (the generated move is used because it also has the move type flags)
     bool valid = false;
 
     for (int i = 0; i < possibleMoves.size(); i++) {
-        if (possibleMoves[i] == move) {
+        if (possibleMoves[i].matches(move)) {
+            move = possibleMoves[i];
             valid = true;
             break;
         }
@@ -343,7 +338,7 @@ void handleInput(GameState& gameState, Vector2& selectedSquare, std::vector<Move
     possibleMoves.clear();
 }
 
-void drawBoard(const GameState& gameState, const std::vector<Move>& possibleMoves, const Vector2& selectedSquare, const std::unordered_map<std::string, Texture2D>& textures, int boardSize, int boardOffsetX, int boardOffsetY, bool isFlipped) {
+void drawBoard(const GameState& gameState, const MoveList& possibleMoves, const Vector2& selectedSquare, const std::unordered_map<std::string, Texture2D>& textures, int boardSize, int boardOffsetX, int boardOffsetY, bool isFlipped) {
     BeginDrawing();
     ClearBackground(BLACK);
 
@@ -429,7 +424,7 @@ void drawBoard(const GameState& gameState, const std::vector<Move>& possibleMove
         int visualX = isFlipped ? 7 - (int)selectedSquare.x : (int)selectedSquare.x;
         int visualY = isFlipped ? 7 - (int)selectedSquare.y : (int)selectedSquare.y;
         
-        Color color = gameState.getPieceAt(selectedSquare.x, selectedSquare.y) != 0 && gameState.getPieceAt(selectedSquare.x, selectedSquare.y)->isWhite() == gameState.isWhiteSideToMove() ? YELLOW : RED;
+        Color color = gameState.getPieceAt(selectedSquare.x, selectedSquare.y) != -1 && isWhitePiece(gameState.getPieceAt(selectedSquare.x, selectedSquare.y)) == gameState.isWhiteSideToMove() ? YELLOW : RED;
         DrawRectangle(boardOffsetX + visualX * (boardSize / 8), boardOffsetY + visualY * (boardSize / 8), (boardSize / 8), (boardSize / 8), ColorAlpha(color, 0.5f));
     }
 
@@ -438,7 +433,7 @@ void drawBoard(const GameState& gameState, const std::vector<Move>& possibleMove
     {
         for (int x = 0; x < 8; x++)
         {
-            Piece* piece = gameState.getPieceAt(x, y);
+            int piece = gameState.getPieceAt(x, y);
             drawPiece(piece, x, y, textures, (boardSize / 8), boardOffsetX, boardOffsetY, isFlipped);
         }
     }
@@ -446,30 +441,20 @@ void drawBoard(const GameState& gameState, const std::vector<Move>& possibleMove
     EndDrawing();
 }
 
-void drawPiece(Piece* piece, int x, int y, const std::unordered_map<std::string, Texture2D>& textures, int squareSize, int offsetX, int offsetY, bool isFlipped)
+void drawPiece(int piece, int x, int y, const std::unordered_map<std::string, Texture2D>& textures, int squareSize, int offsetX, int offsetY, bool isFlipped)
 {
-    if (!piece)
+    if (piece == -1)
         return;
         
     // Apply flipping for visualization
     int visualX = isFlipped ? 7 - x : x;
     int visualY = isFlipped ? 7 - y : y;
 
-    char pieceChar = ' ';
-    if (dynamic_cast<Queen*>(piece))
-        pieceChar = 'Q';
-    else if (dynamic_cast<Pawn*>(piece))
-        pieceChar = 'P';
-    else if (dynamic_cast<Rook*>(piece))
-        pieceChar = 'R';
-    else if (dynamic_cast<Knight*>(piece))
-        pieceChar = 'N';
-    else if (dynamic_cast<Bishop*>(piece))
-        pieceChar = 'B';
-    else if (dynamic_cast<King*>(piece))
-        pieceChar = 'K';
-
-    std::string key = std::string(1, pieceChar) + (piece->isWhite() ? "W" : "B");
+    // The texture characters of the pieces in the PieceType order
+    const char pieceChars[] = { 'B', 'K', 'N', 'P', 'Q', 'R' };
+    char pieceChar = pieceChars[static_cast<int>(pieceTypeOf(piece))];
+
+    std::string key = std::string(1, pieceChar) + (isWhitePiece(piece) ? "W" : "B");
     Texture2D texture = textures.at(key);
 
     Rectangle sourceRec = { 0, 0, (float)texture.width, (float)texture.height };
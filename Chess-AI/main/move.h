@@ -2,44 +2,54 @@
 #define MOVE_H
 
 #include <string>
+#include <cstdint>
 #include "move.h"
 
 /// <summary>
 /// Describes move from one square to another.
-/// Can also contain optional information about piece promotion.
+/// Can also contain optional information about piece promotion and the special type of the move.
+/// The move is packed into 16 bits: bits 0-5 are the 'from' square, bits 6-11 the 'to' square
+/// and bits 12-15 the move flags. A square is X coordinate + Y coordinate * 8 in internal index coordinates.
 /// </summary>
 class Move {
 
-private:
-	/// <summary>
-	/// The 'from' X coordinate of this move.
-	/// The coordinate is stored as internal index coordinate.
-	/// </summary>
-	char _x1;
-
-	/// <summary>
-	/// The 'from' Y coordinate of this move.
-	/// The coordinate is stored as internal index coordinate.
-	/// </summary>
-	char _y1;
-
+public:
 	/// <summary>
-	/// The 'to' X coordinate of this move.
-	/// The coordinate is stored as internal index coordinate.
+	/// The flags that describe the special type of a move.
+	/// The promotion flags can be combined with the Capture flag.
 	/// </summary>
-	char _x2;
+	enum Flag {
+		Quiet = 0,
+		DoublePawnPush = 1,
+		KingSideCastling = 2,
+		QueenSideCastling = 3,
+		Capture = 4,
+		EnPassant = 5,
+		KnightPromotion = 8,
+		BishopPromotion = 9,
+		RookPromotion = 10,
+		QueenPromotion = 11
+	};
 
+private:
 	/// <summary>
-	/// The 'to' Y coordinate of this move.
-	/// The coordinate is stored as internal index coordinate.
+	/// The packed 'from' square, 'to' square and flags of this move.
 	/// </summary>
-	char _y2;
+	uint16_t _data;
 
 	/// <summary>
-	/// The piece this move promotes to.
-	/// ('q' = queen; 'n' = knight; 'b' = bishop; 'r' = rook; -1 = no promotion)
+	/// Converts the given promotion piece char to the promotion flag.
+	/// Returns the Quiet flag if the char is not a promotion piece char.
 	/// </summary>
-	char _promotionPiece;
+	/// <param name="promotionPiece">The char of the promotion piece ('q' = queen; 'n' = knight; 'b' = bishop; 'r' = rook)</param>
+	/// <returns>The promotion flag</returns>
+	static constexpr int promotionFlag(char promotionPiece) {
+		return promotionPiece == 'n' ? KnightPromotion
+			: promotionPiece == 'b' ? BishopPromotion
+			: promotionPiece == 'r' ? RookPromotion
+			: promotionPiece == 'q' ? QueenPromotion
+			: Quiet;
+	}
 
 	/// <summary>
 	/// Converts the given display X coordinate char to internal index coordinate.
@@ -57,40 +67,66 @@ private:
 
 public:
 	/// <summary>
-	/// Checks if the other move is the same as this move.
+	/// Checks if the other move is the same as this move, including the flags.
 	/// </summary>
 	/// <param name="other">The other move</param>
 	/// <returns>True if the other move is the same as this move</returns>
-	bool operator==(const Move& other) const;
+	constexpr bool operator==(const Move& other) const {
+		return _data == other._data;
+	}
 
 	/// <summary>
-	/// Checks if the other move is the same as this move.
+	/// Checks if the other move is the same as this move, including the flags.
 	/// </summary>
 	/// <param name="other">The other move</param>
 	/// <returns>True if the other move is not the same as this move</returns>
-	bool operator!=(const Move& other) const;
+	constexpr bool operator!=(const Move& other) const {
+		return _data != other._data;
+	}
+
+	/// <summary>
+	/// Creates a move with uninitialized coordinates.
+	/// Used for preallocated move storage such as MoveList, so the move must be assigned before use.
+	/// </summary>
+	Move() = default;
+
+	/// <summary>
+	/// Creates a move from the packed 16-bit data of a move (see data()).
+	/// </summary>
+	/// <param name="data">The packed data of the move</param>
+	explicit constexpr Move(uint16_t data) : _data(data) {}
+
+	/// <summary>
+	/// Creates a new move from the 'from' and 'to' squares and the flags of the move.
+	/// </summary>
+	/// <param name="fromSquare">The 'from' square</param>
+	/// <param name="toSquare">The 'to' square</param>
+	/// <param name="flags">The flags of the move (see Flag)</param>
+	constexpr Move(int fromSquare, int toSquare, int flags) : _data(static_cast<uint16_t>(fromSquare | (toSquare << 6) | (flags << 12))) {}
 
 	/// <summary>
 	/// Creates a new move with 'from' and 'to' coordinates.
 	/// All coordinates are given as internal index coordinates.
+	/// The move has no flags.
 	/// </summary>
 	/// <param name="x1">The 'from' X coordinate</param>
 	/// <param name="y1">The 'from' Y coordinate</param>
 	/// <param name="x2">The 'to' X coordinate</param>
 	/// <param name="y2">The 'to' Y coordinate</param>
-	Move(char x1, char y1, char x2, char y2);
+	constexpr Move(char x1, char y1, char x2, char y2) : Move(y1 * 8 + x1, y2 * 8 + x2, Quiet) {}
 
 	/// <summary>
 	/// Creates a new move with 'from' and 'to' coordinates and promotion.
 	/// All coordinates are given as internal index coordinates.
 	/// The promotionPiece char defines which promotion is done ('q' = queen; 'n' = knight; 'b' = bishop; 'r' = rook; -1 = no promotion).
+	/// The move has no other flags than the promotion flag.
 	/// </summary>
 	/// <param name="x1">The 'from' X coordinate</param>
 	/// <param name="y1">The 'from' Y coordinate</param>
 	/// <param name="x2">The 'to' X coordinate</param>
 	/// <param name="y2">The 'to' Y coordinate</param>
 	/// <param name="promotionPiece">The char of the promotion piece (see summary)</param>
-	Move(char x1, char y1, char x2, char y2, char promotionPiece);
+	constexpr Move(char x1, char y1, char x2, char y2, char promotionPiece) : Move(y1 * 8 + x1, y2 * 8 + x2, promotionFlag(promotionPiece)) {}
 
 	/// <summary>
 	/// Creates a new move from string input.
@@ -98,43 +134,136 @@ public:
 	/// The string input is given in the following format: "&lt;x1&gt;&lt;y1&gt;&lt;x2&gt;&lt;y2&gt;[promotionPiece]".
 	/// The promotionPiece defines which promotion is done ('q' = queen; 'n' = knight; 'b' = bishop; 'r' = rook).
 	/// Promotes to queen if promotionPiece is not valid.
+	/// The move has no other flags than the promotion flag, so compare it to generated moves with matches.
 	/// </summary>
 	/// <param name="input">The input string</param>
 	Move(const std::string& input);
 
+	/// <summary>
+	/// Converts the move to string in the same format the Move(const std::string&amp;) constructor accepts
+	/// (for example "e2e4" or "e7e8q").
+	/// </summary>
+	/// <returns>The move as string</returns>
+	std::string toString() const;
+
+	/// <summary>
+	/// Checks if the other move has the same 'from' and 'to' squares and promotion piece as this move.
+	/// The capture, en passant, castling and double pawn push flags are ignored, so a move created
+	/// from user input can be matched to a generated move.
+	/// </summary>
+	/// <param name="other">The other move</param>
+	/// <returns>True if the moves move the same piece to the same square</returns>
+	constexpr bool matches(const Move& other) const {
+		return (_data & 0x0FFF) == (other._data & 0x0FFF) && promotionPiece() == other.promotionPiece();
+	}
+
+	/// <summary>
+	/// The packed 16-bit data of this move. The move can be recreated from the data with Move(uint16_t).
+	/// </summary>
+	/// <returns>The packed data</returns>
+	constexpr uint16_t data() const {
+		return _data;
+	}
+
+	/// <summary>
+	/// The 'from' square of this move.
+	/// </summary>
+	/// <returns>The 'from' square</returns>
+	constexpr int fromSquare() const {
+		return _data & 0x3F;
+	}
+
+	/// <summary>
+	/// The 'to' square of this move.
+	/// </summary>
+	/// <returns>The 'to' square</returns>
+	constexpr int toSquare() const {
+		return (_data >> 6) & 0x3F;
+	}
+
+	/// <summary>
+	/// The flags of this move (see Flag).
+	/// </summary>
+	/// <returns>The flags</returns>
+	constexpr int flags() const {
+		return _data >> 12;
+	}
+
 	/// <summary>
 	/// The 'from' X coordinate of this move.
 	/// The coordinate is given as internal index coordinate.
 	/// </summary>
 	/// <returns>The 'from' X coordinate of this move.</returns>
-	char x1() const;
+	constexpr char x1() const {
+		return static_cast<char>(fromSquare() % 8);
+	}
 
 	/// <summary>
 	/// The 'from' Y coordinate of this move.
 	/// The coordinate is given as internal index coordinate.
 	/// </summary>
 	/// <returns>The 'from' Y coordinate of this move.</returns>
-	char y1() const;
+	constexpr char y1() const {
+		return static_cast<char>(fromSquare() / 8);
+	}
 
 	/// <summary>
 	/// The 'to' X coordinate of this move.
 	/// The coordinate is given as internal index coordinate.
 	/// </summary>
 	/// <returns>The 'to' X coordinate of this move.</returns>
-	char x2() const;
+	constexpr char x2() const {
+		return static_cast<char>(toSquare() % 8);
+	}
 
 	/// <summary>
 	/// The 'to' Y coordinate of this move.
 	/// The coordinate is given as internal index coordinate.
 	/// </summary>
 	/// <returns>The 'to' Y coordinate of this move</returns>
-	char y2() const;
+	constexpr char y2() const {
+		return static_cast<char>(toSquare() / 8);
+	}
 
 	/// <summary>
 	/// The promotion piece of the move. ('q' = queen; 'n' = knight; 'b' = bishop; 'r' = rook; -1 = no promotion)
 	/// </summary>
 	/// <returns></returns>
-	char promotionPiece() const;
+	constexpr char promotionPiece() const {
+		return isPromotion() ? "nbrq"[flags() & 3] : -1;
+	}
+
+	/// <summary>
+	/// Information about if the move is a promotion.
+	/// </summary>
+	/// <returns>True if the move is a promotion</returns>
+	constexpr bool isPromotion() const {
+		return (flags() & KnightPromotion) != 0;
+	}
+
+	/// <summary>
+	/// Information about if the move captures a piece (en passant included).
+	/// </summary>
+	/// <returns>True if the move is a capture</returns>
+	constexpr bool isCapture() const {
+		return (flags() & Capture) != 0;
+	}
+
+	/// <summary>
+	/// Information about if the move is an en passant capture.
+	/// </summary>
+	/// <returns>True if the move is an en passant capture</returns>
+	constexpr bool isEnPassant() const {
+		return flags() == EnPassant;
+	}
+
+	/// <summary>
+	/// Information about if the move is castling.
+	/// </summary>
+	/// <returns>True if the move is castling</returns>
+	constexpr bool isCastling() const {
+		return flags() == KingSideCastling || flags() == QueenSideCastling;
+	}
 
 };
 
@@ -0,0 +1,186 @@
+#ifndef MOVELIST_H
+#define MOVELIST_H
+
+#include "move.h"
+
+/// <summary>
+/// The maximum amount of moves a move list can hold.
+/// No legal chess position has more than 218 moves, so the pseudo-legal moves of any position fit in the list.
+/// </summary>
+constexpr auto MAX_MOVES = 256;
+
+/// <summary>
+/// A fixed-capacity list of moves that is meant to be allocated on the stack.
+/// Every move has a score slot that is used for move ordering.
+/// The list never allocates memory, so generating moves at the search nodes doesn't cause allocator traffic.
+/// </summary>
+class MoveList {
+
+private:
+	/// <summary>
+	/// The moves of the list. Only the first _size moves are valid.
+	/// </summary>
+	Move _moves[MAX_MOVES];
+
+	/// <summary>
+	/// The ordering scores of the moves. Only the first _size scores are valid.
+	/// </summary>
+	int _scores[MAX_MOVES];
+
+	/// <summary>
+	/// The amount of moves in the list.
+	/// </summary>
+	int _size;
+
+public:
+	/// <summary>
+	/// Creates an empty move list.
+	/// </summary>
+	MoveList() : _size(0) {}
+
+	/// <summary>
+	/// Adds the move to the end of the list with score 0.
+	/// </summary>
+	/// <param name="move">The move to add</param>
+	void push_back(const Move& move) {
+		_moves[_size] = move;
+		_scores[_size] = 0;
+		_size++;
+	}
+
+	/// <summary>
+	/// Removes the move at the given position. The order of the remaining moves is kept.
+	/// </summary>
+	/// <param name="position">Pointer to the move to remove</param>
+	void erase(Move* position) {
+		int index = static_cast<int>(position - _moves);
+		for (int i = index; i < _size - 1; i++) {
+			_moves[i] = _moves[i + 1];
+			_scores[i] = _scores[i + 1];
+		}
+		_size--;
+	}
+
+	/// <summary>
+	/// Removes all moves from the list.
+	/// </summary>
+	void clear() {
+		_size = 0;
+	}
+
+	/// <summary>
+	/// Shrinks the list to the given size by removing moves from the end.
+	/// </summary>
+	/// <param name="size">The new size, must not be greater than the current size</param>
+	void resize(int size) {
+		_size = size;
+	}
+
+	/// <summary>
+	/// The amount of moves in the list.
+	/// </summary>
+	/// <returns>The amount of moves</returns>
+	int size() const {
+		return _size;
+	}
+
+	/// <summary>
+	/// Information about if the list has no moves.
+	/// </summary>
+	/// <returns>True if the list is empty</returns>
+	bool empty() const {
+		return _size == 0;
+	}
+
+	/// <summary>
+	/// The move at the given index.
+	/// </summary>
+	/// <param name="index">The index of the move</param>
+	/// <returns>Reference to the move</returns>
+	Move& operator[](int index) {
+		return _moves[index];
+	}
+
+	/// <summary>
+	/// The move at the given index.
+	/// </summary>
+	/// <param name="index">The index of the move</param>
+	/// <returns>Reference to the move</returns>
+	const Move& operator[](int index) const {
+		return _moves[index];
+	}
+
+	/// <summary>
+	/// The ordering score of the move at the given index.
+	/// </summary>
+	/// <param name="index">The index of the move</param>
+	/// <returns>The score of the move</returns>
+	int score(int index) const {
+		return _scores[index];
+	}
+
+	/// <summary>
+	/// Sets the ordering score of the move at the given index.
+	/// </summary>
+	/// <param name="index">The index of the move</param>
+	/// <param name="score">The new score</param>
+	void setScore(int index, int score) {
+		_scores[index] = score;
+	}
+
+	/// <summary>
+	/// Sorts the moves by their scores from the highest to the lowest.
+	/// Uses insertion sort, which is fast for lists of this size and keeps the order of moves with equal scores.
+	/// </summary>
+	void sortByScore() {
+		for (int i = 1; i < _size; i++) {
+			Move move = _moves[i];
+			int score = _scores[i];
+
+			int j = i - 1;
+			while (j >= 0 && _scores[j] < score) {
+				_moves[j + 1] = _moves[j];
+				_scores[j + 1] = _scores[j];
+				j--;
+			}
+
+			_moves[j + 1] = move;
+			_scores[j + 1] = score;
+		}
+	}
+
+	/// <summary>
+	/// Pointer to the first move of the list.
+	/// </summary>
+	/// <returns>The begin iterator</returns>
+	Move* begin() {
+		return _moves;
+	}
+
+	/// <summary>
+	/// Pointer past the last move of the list.
+	/// </summary>
+	/// <returns>The end iterator</returns>
+	Move* end() {
+		return _moves + _size;
+	}
+
+	/// <summary>
+	/// Pointer to the first move of the list.
+	/// </summary>
+	/// <returns>The begin iterator</returns>
+	const Move* begin() const {
+		return _moves;
+	}
+
+	/// <summary>
+	/// Pointer past the last move of the list.
+	/// </summary>
+	/// <returns>The end iterator</returns>
+	const Move* end() const {
+		return _moves + _size;
+	}
+
+};
+
+#endif
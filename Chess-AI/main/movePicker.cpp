@@ -0,0 +1,201 @@
+#include "movePicker.h"
+#include "piece.h"
+#include "gameState/gameState.h"
+#include "chessAI.h"
+
+/// <summary>
+/// The piece types of the promotions in the order of the promotion flags (knight, bishop, rook, queen).
+/// </summary>
+const PieceType promotionPieceTypes[4] = { PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen };
+
+MovePicker::MovePicker(const GameState& state, const Move& transpositionTableMove, const SearchHistory& history, int ply)
+	: _state(state), _transpositionTableMove(transpositionTableMove), _history(&history), _captureOnly(false) {
+	for (int i = 0; i < KILLER_MOVE_COUNT; i++) {
+		_refutations[i] = history.killerMoves[ply][i];
+	}
+	_refutations[KILLER_MOVE_COUNT] = history.counterMove(state);
+}
+
+MovePicker::MovePicker(const GameState& state)
+	: _state(state), _transpositionTableMove(Move(0, 0, 0, 0)), _history(nullptr), _captureOnly(true) {
+	for (Move& refutation : _refutations) {
+		refutation = Move(0, 0, 0, 0);
+	}
+}
+
+bool MovePicker::next(Move& move) {
+	switch (_stage) {
+	case MovePickerStage::TranspositionTableMove:
+		_stage = MovePickerStage::GenerateCaptures;
+
+		// The stored move can be from another position with the same hash, so it must be validated
+		if (_transpositionTableMove != Move(0, 0, 0, 0) && (!_captureOnly || _transpositionTableMove.isCapture()) && _state.isPseudoLegal(_transpositionTableMove)) {
+			move = _transpositionTableMove;
+			return true;
+		}
+		return next(move);
+
+	case MovePickerStage::GenerateCaptures:
+		_stage = MovePickerStage::Captures;
+		_state.pseudoLegalMoves(_moves, true);
+		scoreCaptures();
+		return next(move);
+
+	case MovePickerStage::Captures:
+		while (pickBest(move)) {
+			if (!isLosingCapture(move)) {
+				return true;
+			}
+			if (!_captureOnly) {
+				_badCaptures.push_back(move);
+			}
+		}
+		_stage = _captureOnly ? MovePickerStage::Done : MovePickerStage::Refutations;
+		_nextIndex = 0;
+		return next(move);
+
+	case MovePickerStage::Refutations:
+		while (!_skipQuiets && _nextIndex < KILLER_MOVE_COUNT + 1) {
+			Move& refutation = _refutations[_nextIndex++];
+
+			// The refutations come from other positions, so they must be validated, and they must not repeat the earlier moves
+			bool isRepeated = refutation == _transpositionTableMove;
+			for (int i = 0; i < _nextIndex - 1; i++) {
+				isRepeated = isRepeated || refutation == _refutations[i];
+			}
+			if (refutation == Move(0, 0, 0, 0) || isRepeated || refutation.isCapture() || !_state.isPseudoLegal(refutation)) {
+				refutation = Move(0, 0, 0, 0);
+				continue;
+			}
+
+			move = refutation;
+			return true;
+		}
+		_stage = MovePickerStage::GenerateQuiets;
+		return next(move);
+
+	case MovePickerStage::GenerateQuiets:
+		if (_skipQuiets) {
+			_stage = MovePickerStage::BadCaptures;
+			_nextIndex = 0;
+			return next(move);
+		}
+		_stage = MovePickerStage::Quiets;
+		_moves.clear();
+		_nextIndex = 0;
+		_state.pseudoLegalMoves(_moves);
+		scoreQuiets();
+		return next(move);
+
+	case MovePickerStage::Quiets:
+		if (!_skipQuiets && pickBest(move)) {
+			return true;
+		}
+		_stage = MovePickerStage::BadCaptures;
+		_nextIndex = 0;
+		return next(move);
+
+	case MovePickerStage::BadCaptures:
+		if (_nextIndex < _badCaptures.size()) {
+			move = _badCaptures[_nextIndex++];
+			return true;
+		}
+		_stage = MovePickerStage::Done;
+		return false;
+
+	default:
+		return false;
+	}
+}
+
+void MovePicker::scoreCaptures() {
+	for (int i = 0; i < _moves.size(); i++) {
+		const Move& move = _moves[i];
+		int attacker = _state.getPieceAt(move.x1(), move.y1()) % 6;
+		int victim = move.isEnPassant() ? static_cast<int>(PieceType::Pawn) : _state.getPieceAt(move.x2(), move.y2()) % 6;
+
+		// The victim value dominates, as the difference of two victim values is greater than any attacker value
+		int score = PIECE_MATERIAL_VALUES[victim] * 10 - PIECE_MATERIAL_VALUES[attacker];
+		if (move.isPromotion()) {
+			score += PIECE_MATERIAL_VALUES[static_cast<int>(promotionPieceTypes[move.flags() & 3])];
+		}
+		_moves.setScore(i, score);
+	}
+}
+
+void MovePicker::scoreQuiets() {
+	char gamePhase = _state.gamePhase();
+	bool isWhite = _state.isWhiteSideToMove();
+	int quietCount = 0;
+	for (int i = 0; i < _moves.size(); i++) {
+		Move move = _moves[i];
+
+		// Remove the captures, as they were already picked in the capture stage
+		if (move.isCapture()) {
+			continue;
+		}
+
+		// The piece-square values of the black pieces are negative
+		int piece = _state.getPieceAt(move.x1(), move.y1());
+		int score = pieceSquareValue(piece, move.toSquare(), gamePhase) - pieceSquareValue(piece, move.fromSquare(), gamePhase);
+		if (!isWhitePiece(piece)) {
+			score = -score;
+		}
+		score += _history->historyScore(isWhite, move);
+
+		if (move.isPromotion()) {
+			score += PROMOTION_ORDERING_BONUS + PIECE_MATERIAL_VALUES[static_cast<int>(promotionPieceTypes[move.flags() & 3])];
+		}
+
+		_moves[quietCount] = move;
+		_moves.setScore(quietCount, score);
+		quietCount++;
+	}
+	_moves.resize(quietCount);
+}
+
+bool MovePicker::isLosingCapture(const Move& move) const {
+	// Capturing a piece at least as valuable as the attacker can't lose material
+	int attacker = _state.getPieceAt(move.x1(), move.y1()) % 6;
+	int victim = move.isEnPassant() ? static_cast<int>(PieceType::Pawn) : _state.getPieceAt(move.x2(), move.y2()) % 6;
+	if (STATIC_EXCHANGE_PIECE_VALUES[attacker] <= STATIC_EXCHANGE_PIECE_VALUES[victim]) {
+		return false;
+	}
+
+	return _state.staticExchangeEvaluation(move) < 0;
+}
+
+bool MovePicker::pickBest(Move& move) {
+	while (_nextIndex < _moves.size()) {
+		// Find the highest scored move that has not been picked (selection sort step)
+		int bestIndex = _nextIndex;
+		for (int i = _nextIndex + 1; i < _moves.size(); i++) {
+			if (_moves.score(i) > _moves.score(bestIndex)) {
+				bestIndex = i;
+			}
+		}
+
+		// Move it to the next position, so the moves before the next index are the picked moves
+		Move bestMove = _moves[bestIndex];
+		int bestScore = _moves.score(bestIndex);
+		_moves[bestIndex] = _moves[_nextIndex];
+		_moves.setScore(bestIndex, _moves.score(_nextIndex));
+		_moves[_nextIndex] = bestMove;
+		_moves.setScore(_nextIndex, bestScore);
+		_nextIndex++;
+
+		// Skip the transposition table move and the refutations, as they were picked before generating the moves
+		bool isPicked = bestMove == _transpositionTableMove;
+		for (const Move& refutation : _refutations) {
+			isPicked = isPicked || bestMove == refutation;
+		}
+		if (isPicked) {
+			continue;
+		}
+
+		move = bestMove;
+		return true;
+	}
+
+	return false;
+}
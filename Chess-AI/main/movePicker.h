@@ -0,0 +1,152 @@
+#ifndef MOVEPICKER_H
+#define MOVEPICKER_H
+
+#include "move.h"
+#include "moveList.h"
+#include "chessAI.h"
+
+/// <summary>
+/// The move ordering score added to the quiet promotions, so they are tried before the other quiet moves.
+/// </summary>
+constexpr auto PROMOTION_ORDERING_BONUS = 10000;
+
+/// <summary>
+/// The stages of a move picker in the order they are gone through.
+/// </summary>
+enum class MovePickerStage {
+	TranspositionTableMove,
+	GenerateCaptures,
+	Captures,
+	Refutations,
+	GenerateQuiets,
+	Quiets,
+	BadCaptures,
+	Done
+};
+
+/// <summary>
+/// Gives the pseudo-legal moves of a game state in the order they should be searched.
+/// The moves are generated lazily in stages: first the transposition table move is tried without generating any moves,
+/// then the captures are generated and the ones that don't lose material by static exchange evaluation are given
+/// in MVV-LVA order (most valuable victim first, least valuable attacker first),
+/// then the killer moves and the counter move of the previous move are tried without generating the quiet moves,
+/// then the quiet moves are generated and given in the order of their history score and piece-square value gain,
+/// and finally the losing captures are given. In capture-only mode the losing captures are pruned.
+/// A node that gets a cutoff from an early move never generates the later stages.
+/// The legality of the moves must be checked with GameState::isLegal before they are made.
+/// </summary>
+class MovePicker {
+
+private:
+	/// <summary>
+	/// The game state the moves are picked for.
+	/// </summary>
+	const GameState& _state;
+
+	/// <summary>
+	/// The best move stored in the transposition table, or Move(0, 0, 0, 0) if not available.
+	/// </summary>
+	Move _transpositionTableMove;
+
+	/// <summary>
+	/// The killer moves and the counter move that refuted the sibling nodes and the previous move.
+	/// The moves that are not valid quiet moves in the game state are replaced with Move(0, 0, 0, 0) when they are tried.
+	/// </summary>
+	Move _refutations[KILLER_MOVE_COUNT + 1];
+
+	/// <summary>
+	/// The move ordering history of the search thread, or null if only the captures are picked.
+	/// </summary>
+	const SearchHistory* _history;
+
+	/// <summary>
+	/// If only the captures are picked.
+	/// </summary>
+	bool _captureOnly;
+
+	/// <summary>
+	/// If the remaining quiet moves are skipped.
+	/// </summary>
+	bool _skipQuiets = false;
+
+	/// <summary>
+	/// The current stage.
+	/// </summary>
+	MovePickerStage _stage = MovePickerStage::TranspositionTableMove;
+
+	/// <summary>
+	/// The generated moves of the current stage.
+	/// </summary>
+	MoveList _moves;
+
+	/// <summary>
+	/// The captures that lose material, deferred after the quiet moves in the order they were picked.
+	/// </summary>
+	MoveList _badCaptures;
+
+	/// <summary>
+	/// The index of the next move of the current stage to pick.
+	/// </summary>
+	int _nextIndex = 0;
+
+	/// <summary>
+	/// Scores the generated captures by MVV-LVA.
+	/// </summary>
+	void scoreCaptures();
+
+	/// <summary>
+	/// Removes the captures from the generated moves and scores the remaining quiet moves
+	/// by their history score and the piece-square value gain of the moving piece.
+	/// </summary>
+	void scoreQuiets();
+
+	/// <summary>
+	/// Picks the highest scored move that has not been picked from the moves of the current stage.
+	/// The transposition table move and the refutations are skipped, as they have already been picked.
+	/// </summary>
+	/// <param name="move">Reference parameter that gets the picked move</param>
+	/// <returns>False if the current stage has no moves left</returns>
+	bool pickBest(Move& move);
+
+	/// <summary>
+	/// Information about if the given capture loses material by static exchange evaluation.
+	/// The exchange is evaluated only if the attacker is more valuable than the victim.
+	/// </summary>
+	/// <param name="move">The capture</param>
+	/// <returns>True if the capture loses material</returns>
+	bool isLosingCapture(const Move& move) const;
+
+public:
+	/// <summary>
+	/// Creates a move picker that picks all moves of the given game state.
+	/// </summary>
+	/// <param name="state">The game state to pick the moves for, which must not change while the picker is used</param>
+	/// <param name="transpositionTableMove">The best move stored in the transposition table, give Move(0, 0, 0, 0) if not available</param>
+	/// <param name="history">The move ordering history of the search thread</param>
+	/// <param name="ply">The distance of the game state from the root of the search</param>
+	MovePicker(const GameState& state, const Move& transpositionTableMove, const SearchHistory& history, int ply);
+
+	/// <summary>
+	/// Creates a move picker that picks only the captures of the given game state.
+	/// </summary>
+	/// <param name="state">The game state to pick the captures for, which must not change while the picker is used</param>
+	explicit MovePicker(const GameState& state);
+
+	/// <summary>
+	/// Picks the next move to search.
+	/// </summary>
+	/// <param name="move">Reference parameter that gets the next move</param>
+	/// <returns>False if there are no moves left</returns>
+	bool next(Move& move);
+
+	/// <summary>
+	/// Skips the remaining quiet moves (including the killer moves and the counter move that have not been picked),
+	/// so the picker gives only the remaining captures. Used when the late quiet moves are pruned.
+	/// </summary>
+	void skipQuiets() {
+		_skipQuiets = true;
+	}
+
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include <chrono>
+#include <algorithm>
+#include "perft.h"
+#include "move.h"
+#include "moveList.h"
+
+unsigned long long perft(GameState& state, int depth) {
+	if (depth == 0) {
+		return 1;
+	}
+
+	MoveList moves;
+	state.legalMoves(moves);
+
+	// Bulk counting: every legal move of the last level is a leaf node
+	if (depth == 1) {
+		return moves.size();
+	}
+
+	unsigned long long nodes = 0;
+	UndoRecord undo;
+	for (const Move& move : moves) {
+		state.makeMove(move, undo);
+		nodes += perft(state, depth - 1);
+		state.unmakeMove(undo);
+	}
+
+	return nodes;
+}
+
+unsigned long long perftDivide(GameState& state, int depth, std::ostream& output) {
+	auto startTime = std::chrono::steady_clock::now();
+
+	MoveList moves;
+	state.legalMoves(moves);
+
+	unsigned long long nodes = 0;
+	UndoRecord undo;
+	for (const Move& move : moves) {
+		state.makeMove(move, undo);
+		unsigned long long moveNodes = perft(state, depth - 1);
+		state.unmakeMove(undo);
+
+		nodes += moveNodes;
+		output << move.toString() << ": " << moveNodes << "\n";
+	}
+
+	long long time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+	output << "\nNodes searched: " << nodes << "\n";
+	output << "Time: " << time << " ms, " << nodes * 1000 / std::max(1LL, time) << " nodes per second" << std::endl;
+
+	return nodes;
+}
+
+bool runPerftSuite(std::ostream& output) {
+	bool allCorrect = true;
+	unsigned long long totalNodes = 0;
+	long long totalTime = 0;
+
+	for (const char* fen : INVALID_FENS) {
+		GameState state;
+		bool rejected = !GameState::fromFEN(fen, state);
+		allCorrect = allCorrect && rejected;
+		output << (rejected ? "OK    " : "FAIL  ") << fen << " rejected as invalid" << std::endl;
+	}
+
+	for (const PerftPosition& position : PERFT_SUITE) {
+		GameState state;
+		if (!GameState::fromFEN(position.fen, state)) {
+			output << "Invalid FEN: " << position.fen << std::endl;
+			allCorrect = false;
+			continue;
+		}
+
+		auto startTime = std::chrono::steady_clock::now();
+		unsigned long long nodes = perft(state, position.depth);
+		long long time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+
+		bool correct = nodes == position.nodes;
+		allCorrect = allCorrect && correct;
+		totalNodes += nodes;
+		totalTime += time;
+
+		output << (correct ? "OK    " : "FAIL  ") << position.fen << " depth " << position.depth << ": " << nodes;
+		if (!correct) {
+			output << " (expected " << position.nodes << ")";
+		}
+		output << ", " << time << " ms, " << nodes * 1000 / std::max(1LL, time) << " nodes per second" << std::endl;
+	}
+
+	output << (allCorrect ? "All positions correct" : "Some positions FAILED") << ". Total " << totalNodes << " nodes, "
+		<< totalTime << " ms, " << totalNodes * 1000 / std::max(1LL, totalTime) << " nodes per second" << std::endl;
+
+	return allCorrect;
+}
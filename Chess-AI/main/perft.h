@@ -0,0 +1,91 @@
+#ifndef PERFT_H
+#define PERFT_H
+
+#include <ostream>
+#include "gameState/gameState.h"
+
+/// <summary>
+/// A perft test position with a known node count.
+/// </summary>
+struct PerftPosition {
+	/// <summary>
+	/// The FEN string of the position.
+	/// </summary>
+	const char* fen;
+
+	/// <summary>
+	/// The perft depth.
+	/// </summary>
+	int depth;
+
+	/// <summary>
+	/// The correct amount of leaf nodes at the depth.
+	/// </summary>
+	unsigned long long nodes;
+};
+
+/// <summary>
+/// The amount of positions in the built-in perft suite.
+/// </summary>
+constexpr auto PERFT_SUITE_SIZE = 7;
+
+/// <summary>
+/// The built-in perft suite: the standard test positions that cover castling, en passant, promotions
+/// and discovered checks, with their known node counts. The last position has an en passant target square
+/// without a pawn to capture, which must be ignored.
+/// </summary>
+constexpr PerftPosition PERFT_SUITE[PERFT_SUITE_SIZE] = {
+	{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609 },
+	{ "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603 },
+	{ "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, 674624 },
+	{ "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, 422333 },
+	{ "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487 },
+	{ "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594 },
+	{ "4k3/8/8/4P3/8/8/8/4K3 w - d6 0 1", 6, 55368 }
+};
+
+/// <summary>
+/// The amount of FEN strings the perft suite checks to be rejected.
+/// </summary>
+constexpr auto INVALID_FEN_COUNT = 3;
+
+/// <summary>
+/// FEN strings of illegal positions that GameState::fromFEN must reject: a missing king,
+/// an en passant square on a wrong rank and the side that is not to move in check.
+/// </summary>
+constexpr const char* INVALID_FENS[INVALID_FEN_COUNT] = {
+	"8/8/8/8/8/8/8/4K3 w - - 0 1",
+	"4k3/8/8/8/8/8/8/4K3 w - e5 0 1",
+	"6k1/5ppp/8/8/8/8/5PPP/r5K1 b - - 0 1"
+};
+
+/// <summary>
+/// Counts the leaf nodes of the legal move tree of the given game state to the given depth.
+/// The nodes of the last level are counted from the size of the legal move list without making the moves (bulk counting).
+/// The moves are made and unmade on the given game state, so the game state is unchanged when the function returns.
+/// </summary>
+/// <param name="state">The game state</param>
+/// <param name="depth">The depth (0 counts the game state itself)</param>
+/// <returns>The amount of leaf nodes</returns>
+unsigned long long perft(GameState& state, int depth);
+
+/// <summary>
+/// Runs perft for every legal move of the given game state and writes the node count of every move,
+/// the total node count, the time and the nodes per second to the output.
+/// </summary>
+/// <param name="state">The game state (unchanged when the function returns)</param>
+/// <param name="depth">The depth, at least 1</param>
+/// <param name="output">The stream to write the results to</param>
+/// <returns>The total amount of leaf nodes</returns>
+unsigned long long perftDivide(GameState& state, int depth, std::ostream& output);
+
+/// <summary>
+/// Runs perft for every position of the built-in suite, compares the node counts with the known counts
+/// and writes the results, the time and the nodes per second to the output. Also checks that the invalid
+/// FEN strings are rejected.
+/// </summary>
+/// <param name="output">The stream to write the results to</param>
+/// <returns>True if all node counts were correct</returns>
+bool runPerftSuite(std::ostream& output);
+
+#endif
@@ -1,11 +1,6 @@
 #ifndef PIECE_H
 #define PIECE_H
 
-#include <vector>
-
-class Move;
-class GameState;
-
 /// <summary>
 /// Enum class describing piece types.
 /// These are used for efficient type checking without RTTI.
@@ -20,82 +15,204 @@ enum class PieceType {
 };
 
 /// <summary>
-/// An abstract class that describes a basic chess piece with only color.
-/// The class is immutable, and any child class should be immutable.
+/// The index of the given piece type and color in tables that have a value for every piece.
+/// White pieces have indices 0-5 and black pieces 6-11 in the PieceType order.
 /// </summary>
-class Piece {
+/// <param name="type">The piece type</param>
+/// <param name="isWhite">If the piece is white</param>
+/// <returns>The piece index</returns>
+constexpr int pieceIndex(PieceType type, bool isWhite) {
+	return (isWhite ? 0 : 6) + static_cast<int>(type);
+}
 
-private:
-	/// <summary>
-	/// Information about if the piece is white.
-	/// </summary>
-	const bool _isWhite;
+/// <summary>
+/// The piece type of the given piece index.
+/// </summary>
+/// <param name="pieceIndex">The piece index</param>
+/// <returns>The piece type</returns>
+constexpr PieceType pieceTypeOf(int pieceIndex) {
+	return static_cast<PieceType>(pieceIndex % 6);
+}
 
-public:
-	/// <summary>
-	/// Compares the other piece with this piece.
-	/// </summary>
-	/// <param name="other"></param>
-	/// <returns>True if the pieces are equal</returns>
-	bool operator==(const Piece& other) const;
+/// <summary>
+/// Information about if the piece of the given piece index is white.
+/// </summary>
+/// <param name="pieceIndex">The piece index</param>
+/// <returns>True if the piece is white</returns>
+constexpr bool isWhitePiece(int pieceIndex) {
+	return pieceIndex < 6;
+}
 
-	/// <summary>
-	/// Compares the other piece with this piece.
-	/// </summary>
-	/// <param name="other"></param>
-	/// <returns>True if the pieces are not equal</returns>
-	bool operator!=(const Piece& other) const;
+/// <summary>
+/// The influence of the pieces to the game phase in the PieceType order.
+/// </summary>
+constexpr char PIECE_GAME_PHASE_INFLUENCES[6] = { 1, 0, 1, 0, 4, 2 };
 
-	/// <summary>
-	/// Initializes the piece.
-	/// </summary>
-	/// <param name="isWhite">If the piece is white</param>
-	Piece(bool isWhite);
+/// <summary>
+/// The game phase value above which the game is in the middle game. At or below it the game is in the end game.
+/// </summary>
+constexpr char MIDDLE_GAME_PHASE_THRESHOLD = 10;
 
-	/// <summary>
-	/// Destroys the piece.
-	/// </summary>
-	virtual ~Piece();
+/// <summary>
+/// The material values of the pieces in the PieceType order.
+/// </summary>
+constexpr int PIECE_MATERIAL_VALUES[6] = { 300, 0, 300, 100, 900, 500 };
 
-	/// <summary>
-	/// Information about if the piece is white.
-	/// </summary>
-	/// <returns>True if the piece is white</returns>
-	bool isWhite() const;
+/// <summary>
+/// The piece values used in static exchange evaluation in the PieceType order.
+/// The king is worth more than all other pieces together, so an exchange never continues by giving the king away.
+/// </summary>
+constexpr int STATIC_EXCHANGE_PIECE_VALUES[6] = { 300, 20000, 300, 100, 900, 500 };
 
-	/// <summary>
-	/// The PieceType of this piece.
-	/// </summary>
-	/// <returns></returns>
-	virtual PieceType getType() const = 0;
+/// <summary>
+/// The additions and reductions of the values of the white pieces at different positions in the middle game in the PieceType order.
+/// The first row is the row furthest from the white side.
+/// </summary>
+constexpr int MIDDLE_GAME_VALUE_ADDITIONS[6][8][8] =
+{
+	// Bishop
+	{
+		{-20, -10, -10, -10, -10, -10, -10, -20},
+		{-10, 0, 0, 0, 0, 0, 0, -10},
+		{-10, 0, 5, 10, 10, 5, 0, -10},
+		{-10, 5, 5, 10, 10, 5, 5, -10},
+		{-10, 0, 10, 10, 10, 10, 0, -10},
+		{-10, 10, 10, 10, 10, 10, 10, -10},
+		{-10, 5, 0, 0, 0, 0, 5, -10},
+		{-20, -10, -10, -10, -10, -10, -10, -20}
+	},
+	// King
+	{
+		{-30, -40, -40, -50, -50, -40, -40, -30},
+		{-30, -40, -40, -50, -50, -40, -40, -30},
+		{-30, -40, -40, -50, -50, -40, -40, -30},
+		{-30, -40, -40, -50, -50, -40, -40, -30},
+		{-20, -30, -30, -40, -40, -30, -30, -20},
+		{-10, -20, -20, -20, -20, -20, -20, -10},
+		{20, 20, 0, 0, 0, 0, 20, 20},
+		{20, 30, 10, 0, 0, 10, 30, 20}
+	},
+	// Knight
+	{
+		{-50, -40, -30, -30, -30, -30, -40, -50},
+		{-40, -20, 0, 0, 0, 0, -20, -40},
+		{-30, 0, 10, 15, 15, 10, 0, -30},
+		{-30, 5, 15, 20, 20, 15, 5, -30},
+		{-30, 0, 15, 20, 20, 15, 0, -30},
+		{-30, 5, 10, 15, 15, 10, 5, -30},
+		{-40, -20, 0, 5, 5, 0, -20, -40},
+		{-50, -40, -30, -30, -30, -30, -40, -50}
+	},
+	// Pawn
+	{
+		{0, 0, 0, 0, 0, 0, 0, 0},
+		{50, 50, 50, 50, 50, 50, 50, 50},
+		{10, 10, 20, 30, 30, 20, 10, 10},
+		{5, 5, 10, 25, 25, 10, 5, 5},
+		{0, 0, 0, 20, 20, 0, 0, 0},
+		{5, -5, -10, 0, 0, -10, -5, 5},
+		{5, 10, 10, -20, -20, 10, 10, 5},
+		{0, 0, 0, 0, 0, 0, 0, 0}
+	},
+	// Queen
+	{
+		{-20, -10, -10, -5, -5, -10, -10, -20},
+		{-10, 0, 0, 0, 0, 0, 0, -10},
+		{-10, 0, 5, 5, 5, 5, 0, -10},
+		{-5, 0, 5, 5, 5, 5, 0, -5},
+		{0, 0, 5, 5, 5, 5, 0, -5},
+		{-10, 5, 5, 5, 5, 5, 0, -10},
+		{-10, 0, 5, 0, 0, 0, 0, -10},
+		{-20, -10, -10, -5, -5, -10, -10, -20}
+	},
+	// Rook
+	{
+		{0, 0, 0, 0, 0, 0, 0, 0},
+		{5, 10, 10, 10, 10, 10, 10, 5},
+		{-5, 0, 0, 0, 0, 0, 0, -5},
+		{-5, 0, 0, 0, 0, 0, 0, -5},
+		{-5, 0, 0, 0, 0, 0, 0, -5},
+		{-5, 0, 0, 0, 0, 0, 0, -5},
+		{-5, 0, 0, 0, 0, 0, 0, -5},
+		{0, 0, 0, 5, 5, 0, 0, 0}
+	}
+};
 
-	/// <summary>
-	/// The influence of this piece to the game phase.
-	/// </summary>
-	/// <returns></returns>
-	virtual char gamePhaseInfluence() const = 0;
+/// <summary>
+/// The additions and reductions of the value of the white king at different positions in the end game.
+/// The other pieces use the middle game values also in the end game.
+/// </summary>
+constexpr int END_GAME_KING_VALUE_ADDITIONS[8][8] =
+{
+	{-50, -40, -30, -20, -20, -30, -40, -50},
+	{-30, -20, -10, 0, 0, -10, -20, -30},
+	{-30, -10, 20, 30, 30, 20, -10, -30},
+	{-30, -10, 30, 40, 40, 30, -10, -30},
+	{-30, -10, 30, 40, 40, 30, -10, -30},
+	{-30, -10, 20, 30, 30, 20, -10, -30},
+	{-30, -30, 0, 0, 0, 0, -30, -30},
+	{-50, -30, -30, -30, -30, -30, -30, -50}
+};
 
+/// <summary>
+/// The evaluation values of all pieces at all squares in the middle game and the end game.
+/// The values are from the white side's perspective, so the values of the black pieces are negative.
+/// </summary>
+struct PieceSquareValues {
 	/// <summary>
-	/// Adds the possible moves of this piece to the moves vector.
-	/// Does not take into account if the king is threatened.
-	/// You can generate only capture moves by setting the captureOnly parameter to true.
+	/// The values in the middle game, indexed with the piece index and the square index.
 	/// </summary>
-	/// <param name="moves">The vector where the moves will be added</param>
-	/// <param name="x">The x coordinate of this piece</param>
-	/// <param name="y">The y coordinate of this piece</param>
-	/// <param name="gameState">The game state from which the possible moves are generated</param>
-	/// <param name="captureOnly">If to generate only capture moves</param>
-	virtual void possibleMoves(std::vector<Move>& moves, char x, char y, const GameState& gameState, bool captureOnly = false) const = 0;
+	int middleGame[12][64];
 
 	/// <summary>
-	/// The evaluation value of this piece at the given coordinates at the given game phase.
+	/// The values in the end game, indexed with the piece index and the square index.
 	/// </summary>
-	/// <param name="x">The X coordinate of the piece</param>
-	/// <param name="y">The Y coordinate of the piece</param>
-	/// <param name="gamePhase">The game phase</param>
-	/// <returns>The evaluation value</returns>
-	virtual int evaluationValue(char x, char y, char gamePhase) const = 0;
-
+	int endGame[12][64];
 };
 
+/// <summary>
+/// Generates the evaluation values of the pieces at the squares from the material values and the value additions.
+/// The tables of the black pieces are the mirrored and negated tables of the white pieces.
+/// </summary>
+/// <returns>The piece square values</returns>
+constexpr PieceSquareValues generatePieceSquareValues() {
+	PieceSquareValues values{};
+
+	for (int piece = 0; piece < 12; piece++) {
+		int type = piece % 6;
+		bool isWhite = isWhitePiece(piece);
+
+		for (int square = 0; square < 64; square++) {
+			int x = square % 8;
+			int y = isWhite ? square / 8 : 7 - square / 8;
+			int sign = isWhite ? 1 : -1;
+
+			int middleGameValue = PIECE_MATERIAL_VALUES[type] + MIDDLE_GAME_VALUE_ADDITIONS[type][y][x];
+			int endGameValue = type == static_cast<int>(PieceType::King) ? END_GAME_KING_VALUE_ADDITIONS[y][x] : middleGameValue;
+
+			values.middleGame[piece][square] = middleGameValue * sign;
+			values.endGame[piece][square] = endGameValue * sign;
+		}
+	}
+
+	return values;
+}
+
+/// <summary>
+/// The piece square values, generated at compile time.
+/// </summary>
+constexpr PieceSquareValues PIECE_SQUARE_VALUES = generatePieceSquareValues();
+
+/// <summary>
+/// The evaluation value of the given piece at the given square at the given game phase
+/// from the white side's perspective.
+/// </summary>
+/// <param name="pieceIndex">The piece index</param>
+/// <param name="square">The square index</param>
+/// <param name="gamePhase">The game phase</param>
+/// <returns>The evaluation value</returns>
+inline int pieceSquareValue(int pieceIndex, int square, char gamePhase) {
+	return gamePhase > MIDDLE_GAME_PHASE_THRESHOLD ? PIECE_SQUARE_VALUES.middleGame[pieceIndex][square] : PIECE_SQUARE_VALUES.endGame[pieceIndex][square];
+}
+
 #endif
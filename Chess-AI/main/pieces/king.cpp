@@ -1,50 +1,11 @@
-#include <vector>
 #include <cmath>
 #include "king.h"
 #include "../move.h"
+#include "../moveList.h"
+#include "../bitboard.h"
 #include "../gameState/gameState.h"
 
-/// <summary>
-/// The additions and reductions of the value of white king at different positions in the middle game.
-/// </summary>
-int middleKingValueAdditions[8][8] =
-{
-	{-30, -40, -40, -50, -50, -40, -40, -30},
-	{-30, -40, -40, -50, -50, -40, -40, -30},
-	{-30, -40, -40, -50, -50, -40, -40, -30},
-	{-30, -40, -40, -50, -50, -40, -40, -30},
-	{-20, -30, -30, -40, -40, -30, -30, -20},
-	{-10, -20, -20, -20, -20, -20, -20, -10},
-	{20, 20, 0, 0, 0, 0, 20, 20},
-	{20, 30, 10, 0, 0, 10, 30, 20}
-};
-
-/// <summary>
-/// The additions and reductions of the value of white king at different positions in the end game.
-/// </summary>
-int endKingValueAdditions[8][8] =
-{
-	{-50, -40, -30, -20, -20, -30, -40, -50},
-	{-30, -20, -10, 0, 0, -10, -20, -30},
-	{-30, -10, 20, 30, 30, 20, -10, -30},
-	{-30, -10, 30, 40, 40, 30, -10, -30},
-	{-30, -10, 30, 40, 40, 30, -10, -30},
-	{-30, -10, 20, 30, 30, 20, -10, -30},
-	{-30, -30, 0, 0, 0, 0, -30, -30},
-	{-50, -30, -30, -30, -30, -30, -30, -50}
-};
-
-King::King(bool isWhite) : Piece(isWhite) {}
-
-PieceType King::getType() const {
-	return PieceType::King;
-}
-
-char King::gamePhaseInfluence() const {
-	return 0;
-}
-
-void King::possibleMoves(std::vector<Move>& moves, char x, char y, const GameState& gameState, bool captureOnly) const {
+void King::possibleMoves(MoveList& moves, char x, char y, bool isWhite, const GameState& gameState, bool captureOnly) {
 	// Directions: up, down, left, right
 	char directions[8][2] = { { -1,0 },{ 1,0 },{ 0,-1 },{ 0,1 },{ -1,-1 },{ -1,1 },{ 1,-1 },{ 1,1 } };
 	for (auto& dir : directions) {
@@ -53,36 +14,33 @@ void King::possibleMoves(std::vector<Move>& moves, char x, char y, const GameSta
 		if (dx < 0 || dx > 7 || dy < 0 || dy > 7)
 			continue;
 
-		Piece* p = gameState.getPieceAt(dx, dy);
-		if (p) {
-			if (p->isWhite() != this->isWhite()) {
-				moves.push_back(Move(x, y, dx, dy));
+		uint64_t targetBit = squareBitboard(squareIndex(dx, dy));
+		if (gameState.occupiedBitboard() & targetBit) {
+			if (gameState.colorBitboard(!isWhite) & targetBit) {
+				moves.push_back(Move(squareIndex(x, y), squareIndex(dx, dy), Move::Capture));
 			}
 			continue;
 		}
 		
 		if (!captureOnly) {
-			moves.push_back(Move(x, y, dx, dy));
+			moves.push_back(Move(squareIndex(x, y), squareIndex(dx, dy), Move::Quiet));
 		}
 	}
 
 	// Castling
-	if (!captureOnly && !gameState.isCheck(isWhite())) {
-		char castlingRow = isWhite() ? 7 : 0;
+	if (!captureOnly && !gameState.isCheck(isWhite)) {
+		char castlingRow = isWhite ? 7 : 0;
+		uint64_t occupied = gameState.occupiedBitboard();
 
 		// Left castling
-		if ((isWhite() ? gameState.lowerLeftCastlingPossible() : gameState.upperLeftCastlingPossible()) && gameState.getPieceAt(1, castlingRow) == 0 && gameState.getPieceAt(2, castlingRow) == 0 && gameState.getPieceAt(3, castlingRow) == 0 && !gameState.isThreatened(isWhite(), 2, castlingRow) && !gameState.isThreatened(isWhite(), 3, castlingRow)) {
-			moves.push_back(Move(4, castlingRow, 2, castlingRow));
+		if ((isWhite ? gameState.lowerLeftCastlingPossible() : gameState.upperLeftCastlingPossible()) && !(occupied & squareBitboard(squareIndex(1, castlingRow))) && !(occupied & squareBitboard(squareIndex(2, castlingRow))) && !(occupied & squareBitboard(squareIndex(3, castlingRow))) && !gameState.isThreatened(isWhite, 2, castlingRow) && !gameState.isThreatened(isWhite, 3, castlingRow)) {
+			moves.push_back(Move(squareIndex(4, castlingRow), squareIndex(2, castlingRow), Move::QueenSideCastling));
 		}
 
 		// Right castling
-		if ((isWhite() ? gameState.lowerRightCastlingPossible() : gameState.upperRightCastlingPossible()) && gameState.getPieceAt(5, castlingRow) == 0 && gameState.getPieceAt(6, castlingRow) == 0 && !gameState.isThreatened(isWhite(), 5, castlingRow) && !gameState.isThreatened(isWhite(), 6, castlingRow)) {
-			moves.push_back(Move(4, castlingRow, 6, castlingRow));
+		if ((isWhite ? gameState.lowerRightCastlingPossible() : gameState.upperRightCastlingPossible()) && !(occupied & squareBitboard(squareIndex(5, castlingRow))) && !(occupied & squareBitboard(squareIndex(6, castlingRow))) && !gameState.isThreatened(isWhite, 5, castlingRow) && !gameState.isThreatened(isWhite, 6, castlingRow)) {
+			moves.push_back(Move(squareIndex(4, castlingRow), squareIndex(6, castlingRow), Move::KingSideCastling));
 		}
 	}
 
 }
-
-int King::evaluationValue(char x, char y, char gamePhase) const {
-	return gamePhase > 10 ? middleKingValueAdditions[isWhite() ? y : 7 - y][x] : endKingValueAdditions[isWhite() ? y : 7 - y][x];
-}
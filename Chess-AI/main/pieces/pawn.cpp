@@ -1,43 +1,18 @@
-#include <vector>
 #include <cmath>
 #include "pawn.h"
 #include "../move.h"
-#include "../piece.h"
+#include "../moveList.h"
+#include "../bitboard.h"
 #include "../gameState/gameState.h"
 
-/// <summary>
-/// The additions and reductions of the value of white pawn at different positions.
-/// </summary>
-int pawnValueAdditions[8][8] =
-{
-	{0, 0, 0, 0, 0, 0, 0, 0},
-	{50, 50, 50, 50, 50, 50, 50, 50},
-	{10, 10, 20, 30, 30, 20, 10, 10},
-	{5, 5, 10, 25, 25, 10, 5, 5},
-	{0, 0, 0, 20, 20, 0, 0, 0},
-	{5, -5, -10, 0, 0, -10, -5, 5},
-	{5, 10, 10, -20, -20, 10, 10, 5},
-	{0, 0, 0, 0, 0, 0, 0, 0}
-};
-
-Pawn::Pawn(bool isWhite) : Piece(isWhite) {}
-
-PieceType Pawn::getType() const {
-	return PieceType::Pawn;
-}
-
-char Pawn::gamePhaseInfluence() const {
-	return 0;
-}
-
-void Pawn::possibleMoves(std::vector<Move>& moves, char x, char y, const GameState& gameState, bool captureOnly) const {
+void Pawn::possibleMoves(MoveList& moves, char x, char y, bool isWhite, const GameState& gameState, bool captureOnly) {
 	// There are no possible moves when the pawn is at the top or bottom row
 	if (y == 0 || y == 7) {
 		return;
 	}
 	
 	// The possible movement direction (white moves up and black down)
-	char movementDirection = isWhite() ? -1 : 1;
+	char movementDirection = isWhite ? -1 : 1;
 
 	// Capturing
 	for (char i = (x - 1 > 0 ? x - 1 : 0); i <= x + 1 && i <= 7; i++) {
@@ -47,29 +22,28 @@ void Pawn::possibleMoves(std::vector<Move>& moves, char x, char y, const GameSta
 		}
 
 		// Check if there is opponent's piece at the square
-		Piece* pieceToCapture = gameState.getPieceAt(i, y + movementDirection);
-		if (pieceToCapture == 0 || pieceToCapture->isWhite() == isWhite()) {
+		if (!(gameState.colorBitboard(!isWhite) & squareBitboard(squareIndex(i, y + movementDirection)))) {
 			continue;
 		}
 
 		// Capturing move without promotion
 		if (y + movementDirection != 0 && y + movementDirection != 7) {
-			moves.push_back(Move(x, y, i, y + movementDirection));
+			moves.push_back(Move(squareIndex(x, y), squareIndex(i, y + movementDirection), Move::Capture));
 			continue;
 		}
 
 		// Capturing move with promotion
-		moves.push_back(Move(x, y, i, y + movementDirection, 'q'));
-		moves.push_back(Move(x, y, i, y + movementDirection, 'n'));
-		moves.push_back(Move(x, y, i, y + movementDirection, 'b'));
-		moves.push_back(Move(x, y, i, y + movementDirection, 'r'));
+		moves.push_back(Move(squareIndex(x, y), squareIndex(i, y + movementDirection), Move::Capture | Move::QueenPromotion));
+		moves.push_back(Move(squareIndex(x, y), squareIndex(i, y + movementDirection), Move::Capture | Move::KnightPromotion));
+		moves.push_back(Move(squareIndex(x, y), squareIndex(i, y + movementDirection), Move::Capture | Move::BishopPromotion));
+		moves.push_back(Move(squareIndex(x, y), squareIndex(i, y + movementDirection), Move::Capture | Move::RookPromotion));
 	}
 
 	// En passant
 	if (gameState.upperEnPassantColumn() != -1 && movementDirection == -1 && y == 3 && std::abs(gameState.upperEnPassantColumn() - x) == 1) {
-		moves.push_back(Move(x, y, gameState.upperEnPassantColumn(), 2));
+		moves.push_back(Move(squareIndex(x, y), squareIndex(gameState.upperEnPassantColumn(), 2), Move::EnPassant));
 	} else if (gameState.lowerEnPassantColumn() != -1 && movementDirection == 1 && y == 4 && std::abs(gameState.lowerEnPassantColumn() - x) == 1) {
-		moves.push_back(Move(x, y, gameState.lowerEnPassantColumn(), 5));
+		moves.push_back(Move(squareIndex(x, y), squareIndex(gameState.lowerEnPassantColumn(), 5), Move::EnPassant));
 	}
 
 	// Don't generate normal moves if only capture moves are needed
@@ -78,28 +52,24 @@ void Pawn::possibleMoves(std::vector<Move>& moves, char x, char y, const GameSta
 	}
 
 	// Prevent moving forward when there is an obstacle
-	if (gameState.getPieceAt(x, y + movementDirection) != 0) {
+	if (gameState.occupiedBitboard() & squareBitboard(squareIndex(x, y + movementDirection))) {
 		return;
 	}
 
 	// Normal forward move without promotion
 	if ((movementDirection == -1 && y > 1) || (movementDirection == 1 && y < 6)) {
-		moves.push_back(Move(x, y, x, y + movementDirection));
+		moves.push_back(Move(squareIndex(x, y), squareIndex(x, y + movementDirection), Move::Quiet));
 	}
 	// Normal forward move with promotion
 	else {
-		moves.push_back(Move(x, y, x, y + movementDirection, 'q'));
-		moves.push_back(Move(x, y, x, y + movementDirection, 'n'));
-		moves.push_back(Move(x, y, x, y + movementDirection, 'b'));
-		moves.push_back(Move(x, y, x, y + movementDirection, 'r'));
+		moves.push_back(Move(squareIndex(x, y), squareIndex(x, y + movementDirection), Move::QueenPromotion));
+		moves.push_back(Move(squareIndex(x, y), squareIndex(x, y + movementDirection), Move::KnightPromotion));
+		moves.push_back(Move(squareIndex(x, y), squareIndex(x, y + movementDirection), Move::BishopPromotion));
+		moves.push_back(Move(squareIndex(x, y), squareIndex(x, y + movementDirection), Move::RookPromotion));
 	}
 
 	// Double move
-	if (((y == 6 && movementDirection == -1) || (y == 1 && movementDirection == 1)) && gameState.getPieceAt(x, y + movementDirection * 2) == 0) {
-		moves.push_back(Move(x, y, x, y + movementDirection * 2));
+	if (((y == 6 && movementDirection == -1) || (y == 1 && movementDirection == 1)) && !(gameState.occupiedBitboard() & squareBitboard(squareIndex(x, y + movementDirection * 2)))) {
+		moves.push_back(Move(squareIndex(x, y), squareIndex(x, y + movementDirection * 2), Move::DoublePawnPush));
 	}
 }
-
-int Pawn::evaluationValue(char x, char y, char gamePhase) const {
-	return 100 + pawnValueAdditions[isWhite() ? y : 7 - y][x];
-}
@@ -1,57 +1,27 @@
 #ifndef PAWN_H
 #define PAWN_H
 
-#include <vector>
-#include "../piece.h"
-
-class Move;
+class MoveList;
 class GameState;
 
 /// <summary>
-/// A class that describes a pawn piece.
-/// The class is immutable, and any child class should be immutable.
+/// A static class that generates the moves of a pawn piece.
 /// </summary>
-class Pawn : public Piece {
+class Pawn {
 
 public:
 	/// <summary>
-	/// Initializes this pawn.
-	/// </summary>
-	/// <param name="isWhite">If the pawn is white</param>
-	Pawn(bool isWhite);
-
-	/// <summary>
-	/// The PieceType of this piece.
-	/// </summary>
-	/// <returns></returns>
-	PieceType getType() const override;
-
-	/// <summary>
-	/// The influence of this piece to the game phase.
-	/// </summary>
-	/// <returns></returns>
-	char gamePhaseInfluence() const override;
-
-	/// <summary>
-	/// Adds the possible moves of this piece to the moves vector.
+	/// Adds the possible moves of a pawn of the given color at the given coordinates to the move list.
 	/// Does not take into account if the king is threatened.
 	/// You can generate only capture moves by setting the captureOnly parameter to true.
 	/// </summary>
-	/// <param name="moves">The vector where the moves will be added</param>
-	/// <param name="x">The x coordinate of this piece</param>
-	/// <param name="y">The y coordinate of this piece</param>
+	/// <param name="moves">The move list where the moves will be added</param>
+	/// <param name="x">The x coordinate of the pawn</param>
+	/// <param name="y">The y coordinate of the pawn</param>
+	/// <param name="isWhite">If the pawn is white</param>
 	/// <param name="gameState">The game state from which the possible moves are generated</param>
 	/// <param name="captureOnly">If to generate only capture moves</param>
-	void possibleMoves(std::vector<Move>& moves, char x, char y, const GameState& gameState, bool captureOnly = false) const override;
-
-	/// <summary>
-	/// The evaluation value of this piece at the given coordinates at the given game phase.
-	/// </summary>
-	/// <param name="x">The X coordinate of the piece</param>
-	/// <param name="y">The Y coordinate of the piece</param>
-	/// <param name="gamePhase">The game phase</param>
-	/// <returns>The evaluation value</returns>
-	int evaluationValue(char x, char y, char gamePhase) const override;
+	static void possibleMoves(MoveList& moves, char x, char y, bool isWhite, const GameState& gameState, bool captureOnly = false);
 
 };
 
@@ -1,41 +1,17 @@
-#include <vector>
 #include "queen.h"
 #include "../move.h"
+#include "../moveList.h"
+#include "../bitboard.h"
 #include "../gameState/gameState.h"
 
-/// <summary>
-/// The additions and reductions of the value of white queen at different positions.
-/// </summary>
-int queenValueAdditions[8][8] =
-{
-	{-20, -10, -10, -5, -5, -10, -10, -20},
-	{-10, 0, 0, 0, 0, 0, 0, -10},
-	{-10, 0, 5, 5, 5, 5, 0, -10},
-	{-5, 0, 5, 5, 5, 5, 0, -5},
-	{0, 0, 5, 5, 5, 5, 0, -5},
-	{-10, 5, 5, 5, 5, 5, 0, -10},
-	{-10, 0, 5, 0, 0, 0, 0, -10},
-	{-20, -10, -10, -5, -5, -10, -10, -20}
-};
+void Queen::possibleMoves(MoveList& moves, char x, char y, bool isWhite, const GameState& gameState, bool captureOnly) {
+	// Look up the diagonal and straight attacks at once and remove the squares of own pieces (or all non-capturing squares)
+	uint64_t targets = Bitboards::queenAttacks(squareIndex(x, y), gameState.occupiedBitboard());
+	targets &= captureOnly ? gameState.colorBitboard(!isWhite) : ~gameState.colorBitboard(isWhite);
 
-Queen::Queen(bool isWhite) : Bishop(isWhite), Rook(isWhite), Piece(isWhite) {}
-
-PieceType Queen::getType() const {
-	return PieceType::Queen;
-}
-
-char Queen::gamePhaseInfluence() const {
-	return 4;
-}
-
-void Queen::possibleMoves(std::vector<Move>& moves, char x, char y, const GameState& gameState, bool captureOnly) const {
-	// Get diagonal moves from Bishop
-	Bishop::possibleMoves(moves, x, y, gameState, captureOnly);
-
-	// Get straight moves from Rook
-	Rook::possibleMoves(moves, x, y, gameState, captureOnly);
-}
-
-int Queen::evaluationValue(char x, char y, char gamePhase) const {
-	return 900 + queenValueAdditions[isWhite() ? y : 7 - y][x];
+	uint64_t opponentPieces = gameState.colorBitboard(!isWhite);
+	while (targets) {
+		int target = popLeastSignificantSquare(targets);
+		moves.push_back(Move(squareIndex(x, y), target, (opponentPieces & squareBitboard(target)) ? Move::Capture : Move::Quiet));
+	}
 }
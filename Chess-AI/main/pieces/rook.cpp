@@ -1,60 +1,17 @@
-#include <vector>
 #include "rook.h"
 #include "../move.h"
+#include "../moveList.h"
+#include "../bitboard.h"
 #include "../gameState/gameState.h"
 
-/// <summary>
-/// The additions and reductions of the value of white rook at different positions.
-/// </summary>
-int rookValueAdditions[8][8] =
-{
-	{0, 0, 0, 0, 0, 0, 0, 0},
-	{5, 10, 10, 10, 10, 10, 10, 5},
-	{-5, 0, 0, 0, 0, 0, 0, -5},
-	{-5, 0, 0, 0, 0, 0, 0, -5},
-	{-5, 0, 0, 0, 0, 0, 0, -5},
-	{-5, 0, 0, 0, 0, 0, 0, -5},
-	{-5, 0, 0, 0, 0, 0, 0, -5},
-	{0, 0, 0, 5, 5, 0, 0, 0}
-};
+void Rook::possibleMoves(MoveList& moves, char x, char y, bool isWhite, const GameState& gameState, bool captureOnly) {
+	// Look up the straight attacks and remove the squares of own pieces (or all non-capturing squares)
+	uint64_t targets = Bitboards::rookAttacks(squareIndex(x, y), gameState.occupiedBitboard());
+	targets &= captureOnly ? gameState.colorBitboard(!isWhite) : ~gameState.colorBitboard(isWhite);
 
-Rook::Rook(bool isWhite) : Piece(isWhite) {}
-
-PieceType Rook::getType() const {
-	return PieceType::Rook;
-}
-
-char Rook::gamePhaseInfluence() const {
-	return 2;
-}
-
-void Rook::possibleMoves(std::vector<Move>& moves, char x, char y, const GameState& gameState, bool captureOnly) const {
-	// Directions: up, down, left, right
-	char directions[4][2] = { {-1,0}, {1,0}, {0,-1}, {0,1} };
-	for (auto& dir : directions) {
-		char dx = x;
-		char dy = y;
-		while (true) {
-			dx += dir[0];
-			dy += dir[1];
-			if (dx < 0 || dx > 7 || dy < 0 || dy > 7)
-				break;
-
-			Piece* p = gameState.getPieceAt(dx, dy);
-			if (p) {
-				if (p->isWhite() != this->isWhite()) {
-					moves.push_back(Move(x, y, dx, dy));
-				}
-				break;
-			}
-			
-			if (!captureOnly) {
-				moves.push_back(Move(x, y, dx, dy));
-			}
-		}
+	uint64_t opponentPieces = gameState.colorBitboard(!isWhite);
+	while (targets) {
+		int target = popLeastSignificantSquare(targets);
+		moves.push_back(Move(squareIndex(x, y), target, (opponentPieces & squareBitboard(target)) ? Move::Capture : Move::Quiet));
 	}
 }
-
-int Rook::evaluationValue(char x, char y, char gamePhase) const {
-	return 500 + rookValueAdditions[isWhite() ? y : 7 - y][x];
-}
@@ -0,0 +1,70 @@
+#include "threadPool.h"
+
+ThreadPool::~ThreadPool() {
+	stopWorkers();
+}
+
+void ThreadPool::workerLoop(int threadIndex, unsigned long long jobId) {
+	while (true) {
+		// Wait for a new job or exit
+		std::function<void(int)> job;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_jobCondition.wait(lock, [this, jobId]() { return _exit || _jobId != jobId; });
+			if (_exit) {
+				return;
+			}
+
+			jobId = _jobId;
+			job = _job;
+		}
+
+		job(threadIndex);
+
+		// Tell the calling thread if this was the last worker running the job
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (--_runningWorkers == 0) {
+			_finishedCondition.notify_all();
+		}
+	}
+}
+
+void ThreadPool::stopWorkers() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_exit = true;
+	}
+	_jobCondition.notify_all();
+
+	for (std::thread& worker : _workers) {
+		worker.join();
+	}
+	_workers.clear();
+	_exit = false;
+}
+
+void ThreadPool::resize(int threadCount) {
+	stopWorkers();
+
+	for (int i = 1; i < threadCount; i++) {
+		_workers.emplace_back(&ThreadPool::workerLoop, this, i, _jobId);
+	}
+}
+
+void ThreadPool::run(const std::function<void(int)>& job) {
+	// Give the job to the workers
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_job = job;
+		_runningWorkers = static_cast<int>(_workers.size());
+		_jobId++;
+	}
+	_jobCondition.notify_all();
+
+	// Take part in the job with the calling thread
+	job(0);
+
+	// Wait for the workers to finish
+	std::unique_lock<std::mutex> lock(_mutex);
+	_finishedCondition.wait(lock, [this]() { return _runningWorkers == 0; });
+}
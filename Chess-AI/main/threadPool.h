@@ -0,0 +1,105 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/// <summary>
+/// A pool of persistent threads that run the same job in parallel.
+/// The threads are created once and wait for jobs, so running a job doesn't create or destroy any threads.
+/// The thread calling run takes part in the job as the thread with index 0.
+/// </summary>
+class ThreadPool {
+
+private:
+	/// <summary>
+	/// The worker threads of the pool. The worker at position i runs the job with thread index i + 1.
+	/// </summary>
+	std::vector<std::thread> _workers;
+
+	/// <summary>
+	/// The mutex protecting the job state of the pool.
+	/// </summary>
+	std::mutex _mutex;
+
+	/// <summary>
+	/// Condition variable the workers wait for a new job with.
+	/// </summary>
+	std::condition_variable _jobCondition;
+
+	/// <summary>
+	/// Condition variable the calling thread waits for the workers to finish with.
+	/// </summary>
+	std::condition_variable _finishedCondition;
+
+	/// <summary>
+	/// The current job.
+	/// </summary>
+	std::function<void(int)> _job;
+
+	/// <summary>
+	/// The identifier of the current job. Incremented for every job so the workers can detect new jobs.
+	/// </summary>
+	unsigned long long _jobId = 0;
+
+	/// <summary>
+	/// The amount of workers that have not finished the current job.
+	/// </summary>
+	int _runningWorkers = 0;
+
+	/// <summary>
+	/// Flag telling the workers to exit.
+	/// </summary>
+	bool _exit = false;
+
+	/// <summary>
+	/// The loop of a worker thread. Waits for jobs and runs them until the pool tells the workers to exit.
+	/// </summary>
+	/// <param name="threadIndex">The thread index of the worker</param>
+	/// <param name="jobId">The identifier of the last job that existed when the worker was created</param>
+	void workerLoop(int threadIndex, unsigned long long jobId);
+
+	/// <summary>
+	/// Tells all workers to exit and waits for them.
+	/// </summary>
+	void stopWorkers();
+
+public:
+	/// <summary>
+	/// Creates a pool with only the calling thread.
+	/// </summary>
+	ThreadPool() = default;
+
+	/// <summary>
+	/// Stops the worker threads.
+	/// </summary>
+	~ThreadPool();
+
+	/// <summary>
+	/// Sets the amount of threads in the pool (the calling thread included).
+	/// Must not be called while a job is running.
+	/// </summary>
+	/// <param name="threadCount">The amount of threads, at least 1</param>
+	void resize(int threadCount);
+
+	/// <summary>
+	/// The amount of threads in the pool (the calling thread included).
+	/// </summary>
+	/// <returns>The amount of threads</returns>
+	int size() const {
+		return static_cast<int>(_workers.size()) + 1;
+	}
+
+	/// <summary>
+	/// Runs the job on every thread of the pool and waits until all threads have finished it.
+	/// The job gets the thread index (0 for the calling thread) as its parameter.
+	/// </summary>
+	/// <param name="job">The job to run</param>
+	void run(const std::function<void(int)>& job);
+
+};
+
+#endif
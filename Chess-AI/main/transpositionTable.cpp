@@ -1,46 +1,201 @@
+#include <limits>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <algorithm>
 #include "transpositionTable.h"
 
-template<size_t Size>
-inline void TranspositionTable<Size>::store(const GameState& state, int evaluationValue, int evaluationDepth, bool evaluatedForWhite, TranspositionTableItemType itemType, const Move& bestMove) {
-	// Calculate the transposition table slot of the game state
-	int index = state.hash() % Size;
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
 
-	// Don't update value if the slot has a deeper value than the new value
-	TranspositionTableItem item = _items[index].load();
-	if (item.evaluationDepth > evaluationDepth) {
-		return;
+/// <summary>
+/// The alignment of the table memory. Aligning the table to the huge page size lets the kernel back it with huge pages.
+/// </summary>
+constexpr size_t TRANSPOSITION_TABLE_ALIGNMENT = 2 * 1024 * 1024;
+
+/// <summary>
+/// Allocates the given amount of memory for the table buckets.
+/// On Linux, advises the kernel to back the memory with transparent huge pages, which reduces TLB misses on table probes.
+/// </summary>
+/// <param name="bytes">The amount of bytes to allocate (a power of two)</param>
+/// <returns>The allocated memory, or null if the allocation failed</returns>
+static void* allocateTableMemory(size_t bytes) {
+	size_t alignment = std::min(bytes, TRANSPOSITION_TABLE_ALIGNMENT);
+#if defined(_WIN32)
+	return _aligned_malloc(bytes, alignment);
+#else
+	void* memory = std::aligned_alloc(alignment, bytes);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	if (memory) {
+		madvise(memory, bytes, MADV_HUGEPAGE);
+	}
+#endif
+	return memory;
+#endif
+}
+
+/// <summary>
+/// Frees memory allocated with allocateTableMemory.
+/// </summary>
+/// <param name="memory">The memory to free</param>
+static void freeTableMemory(void* memory) {
+#if defined(_WIN32)
+	_aligned_free(memory);
+#else
+	std::free(memory);
+#endif
+}
+
+TranspositionTable::~TranspositionTable() {
+	free();
+}
+
+void TranspositionTable::free() {
+	if (_buckets) {
+		freeTableMemory(_buckets);
+		_buckets = nullptr;
+		_bucketCount = 0;
+	}
+}
+
+size_t TranspositionTable::resize(size_t megabytes) {
+	// Round the bucket count down to a power of two. The size is calculated in 64 bits and limited to what fits in size_t,
+	// as the size in bytes overflows size_t on 32-bit platforms
+	uint64_t bytes = std::min<uint64_t>(static_cast<uint64_t>(megabytes) * 1024 * 1024, std::numeric_limits<size_t>::max());
+	uint64_t bucketCount = 1;
+	while (bucketCount * 2 * sizeof(TranspositionTableBucket) <= bytes) {
+		bucketCount *= 2;
+	}
+
+	// Allocate the new table before freeing the old one, and fall back to smaller tables if the allocation fails
+	TranspositionTableBucket* buckets = nullptr;
+	while (!buckets) {
+		buckets = static_cast<TranspositionTableBucket*>(allocateTableMemory(static_cast<size_t>(bucketCount * sizeof(TranspositionTableBucket))));
+		if (!buckets) {
+			if (bucketCount == 1) {
+				break;
+			}
+			bucketCount /= 2;
+		}
 	}
 
-	// Update the new values to the slot
-	item.itemType = itemType;
-	item.hash = state.hash();
+	// Keep the old table if no table could be allocated
+	if (!buckets) {
+		if (!_buckets) {
+			throw std::bad_alloc();
+		}
+		clear(std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+		return _bucketCount * sizeof(TranspositionTableBucket) / (1024 * 1024);
+	}
 
-	item.evaluationValue = evaluationValue;
-	item.evaluationDepth = evaluationDepth;
-	item.evaluatedForWhite = evaluatedForWhite;
-	item.bestMove = bestMove;
+	free();
+	_buckets = buckets;
+	_bucketCount = static_cast<size_t>(bucketCount);
 
-	_items[index].store(item);
+	clear(std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+	return _bucketCount * sizeof(TranspositionTableBucket) / (1024 * 1024);
 }
 
-template<size_t Size>
-bool TranspositionTable<Size>::lookup(const GameState& state, int minDepth, bool evaluateForWhite, int& evaluationValue, Move& bestMove, TranspositionTableItemType& itemType) {
-	// Calculate the transposition table slot of the game state
-	int index = state.hash() % Size;
+void TranspositionTable::clear(int threadCount) {
+	// Every thread zeroes its own slice of the buckets (a zeroed entry doesn't verify against any hash other than 0)
+	size_t slice = (_bucketCount + threadCount - 1) / threadCount;
+	std::vector<std::thread> threads;
+	for (int i = 0; i < threadCount; i++) {
+		size_t first = std::min(_bucketCount, slice * i);
+		size_t count = std::min(_bucketCount, first + slice) - first;
+		threads.emplace_back([this, first, count]() {
+			std::memset(static_cast<void*>(_buckets + first), 0, count * sizeof(TranspositionTableBucket));
+		});
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
 
-	// Correct result was not found if the slot doesn't contain item with the correct hash or the item has too small depth
-	TranspositionTableItem item = _items[index].load();
-	if (item.hash != state.hash() || item.evaluatedForWhite != evaluateForWhite || item.evaluationDepth < minDepth) {
-		return false;
+int TranspositionTable::hashfull() const {
+	// Count the used entries of the current generation in the first 1000 entries (empty entries have depth 0)
+	int sampledBuckets = static_cast<int>(std::min<size_t>(_bucketCount, 1000 / TRANSPOSITION_TABLE_BUCKET_SIZE));
+	int usedEntries = 0;
+	for (int i = 0; i < sampledBuckets; i++) {
+		for (const TranspositionTableEntry& entry : _buckets[i].entries) {
+			uint64_t data = entry.data.load(std::memory_order_relaxed);
+			if (TranspositionTableEntry::evaluationDepth(data) > 0 && TranspositionTableEntry::generation(data) == _generation) {
+				usedEntries++;
+			}
+		}
 	}
 
-	// Set the evaluation value, best value, and item type reference parameters to the values of the table item
-	evaluationValue = item.evaluationValue;
-	bestMove = item.bestMove;
-	itemType = item.itemType;
+	return usedEntries * 1000 / (sampledBuckets * TRANSPOSITION_TABLE_BUCKET_SIZE);
+}
+
+void TranspositionTable::store(const GameState& state, int evaluationValue, int evaluationDepth, TranspositionTableItemType itemType, const Move& bestMove) {
+	// Calculate the transposition table bucket of the game state
+	TranspositionTableBucket& stateBucket = bucket(state.hash());
+
+	// Find the entry to replace: the entry of the same game state, or the entry with the lowest replacement value
+	TranspositionTableEntry* replacedEntry = &stateBucket.entries[0];
+	int replacedValue = std::numeric_limits<int>::max();
+	for (TranspositionTableEntry& entry : stateBucket.entries) {
+		uint64_t data = entry.data.load(std::memory_order_relaxed);
+		uint64_t key = entry.key.load(std::memory_order_relaxed);
+		int age = (_generation - TranspositionTableEntry::generation(data) + TRANSPOSITION_TABLE_GENERATIONS) % TRANSPOSITION_TABLE_GENERATIONS;
+
+		// Don't update value if the game state already has a deeper value from the current search than the new value
+		if ((key ^ data) == state.hash()) {
+			if (age == 0 && TranspositionTableEntry::evaluationDepth(data) > evaluationDepth) {
+				return;
+			}
+
+			replacedEntry = &entry;
+			break;
+		}
+
+		// Items from earlier searches are replaced before deeper items from the current search
+		int value = TranspositionTableEntry::evaluationDepth(data) - age * 8;
+		if (value < replacedValue) {
+			replacedEntry = &entry;
+			replacedValue = value;
+		}
+	}
 
-	// Return true as correct result was found
-	return true;
+	// Update the new values to the entry
+	uint64_t data = TranspositionTableEntry::packData(evaluationValue, evaluationDepth, itemType, bestMove, _generation);
+	replacedEntry->key.store(state.hash() ^ data, std::memory_order_relaxed);
+	replacedEntry->data.store(data, std::memory_order_relaxed);
 }
 
-template class TranspositionTable<30000000>;
+bool TranspositionTable::lookup(const GameState& state, int minDepth, int& evaluationValue, Move& bestMove, TranspositionTableItemType& itemType) {
+	// Calculate the transposition table bucket of the game state
+	TranspositionTableBucket& stateBucket = bucket(state.hash());
+
+	for (TranspositionTableEntry& entry : stateBucket.entries) {
+		// The entry is not of the game state if the key doesn't verify with the data (includes torn writes)
+		uint64_t data = entry.data.load(std::memory_order_relaxed);
+		uint64_t key = entry.key.load(std::memory_order_relaxed);
+		if ((key ^ data) != state.hash()) {
+			continue;
+		}
+
+		// The best move of a shallower item is still the best guess for ordering the moves,
+		// but its evaluation value can't be used if the item has too small depth
+		bestMove = TranspositionTableEntry::bestMove(data);
+		if (TranspositionTableEntry::evaluationDepth(data) < minDepth) {
+			return false;
+		}
+
+		// Set the evaluation value and item type reference parameters to the values of the table item
+		evaluationValue = TranspositionTableEntry::evaluationValue(data);
+		itemType = TranspositionTableEntry::itemType(data);
+
+		// Return true as correct result was found
+		return true;
+	}
+
+	return false;
+}
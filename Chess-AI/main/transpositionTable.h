@@ -1,10 +1,22 @@
 #ifndef TRANSPOSITIONTABLE_H
 #define TRANSPOSITIONTABLE_H
 
-#include <mutex>
+#include <atomic>
+#include <cstdint>
 #include "move.h"
 #include "gameState/gameState.h"
 
+/// <summary>
+/// The amount of entries in one transposition table bucket.
+/// Four 16-byte entries fill one 64-byte cache line.
+/// </summary>
+constexpr auto TRANSPOSITION_TABLE_BUCKET_SIZE = 4;
+
+/// <summary>
+/// The amount of different search generations an entry can store. The generation wraps around after this.
+/// </summary>
+constexpr auto TRANSPOSITION_TABLE_GENERATIONS = 32;
+
 /// <summary>
 /// An enum class describing transposition table item type.
 /// </summary>
@@ -30,83 +42,219 @@ enum class TranspositionTableItemType {
 };
 
 /// <summary>
-/// A struct describing transposition table item.
+/// A struct describing a transposition table entry.
+/// The item is packed into the 64-bit data word: bits 0-31 are the evaluation value, bits 32-47 the best move,
+/// bits 48-55 the evaluation depth, bits 56-57 the item type and bits 59-63 the search generation the item was stored at.
+/// The evaluation value is from the perspective of the side to move, so the item serves the searches of both sides.
+/// The key word is the hash of the game state XORed with the data word. A torn entry (the key and data
+/// written by different threads) doesn't verify against the hash, so the entry doesn't need any lock.
 /// </summary>
-struct TranspositionTableItem {
+struct TranspositionTableEntry {
+	/// <summary>
+	/// The hash of the game state XORed with the data of the entry.
+	/// </summary>
+	std::atomic<uint64_t> key;
+
 	/// <summary>
-	/// The type of the item.
+	/// The packed data of the entry.
 	/// </summary>
-	TranspositionTableItemType itemType = TranspositionTableItemType::Exact;
+	std::atomic<uint64_t> data;
+
+	/// <summary>
+	/// Packs the given values to an entry data word.
+	/// </summary>
+	/// <param name="evaluationValue">The evaluation value</param>
+	/// <param name="evaluationDepth">The evaluation depth (0-255)</param>
+	/// <param name="itemType">The item type</param>
+	/// <param name="bestMove">The best move</param>
+	/// <param name="generation">The search generation</param>
+	/// <returns>The packed data</returns>
+	static uint64_t packData(int evaluationValue, int evaluationDepth, TranspositionTableItemType itemType, const Move& bestMove, int generation) {
+		return static_cast<uint64_t>(static_cast<uint32_t>(evaluationValue))
+			| (static_cast<uint64_t>(bestMove.data()) << 32)
+			| (static_cast<uint64_t>(evaluationDepth & 0xFF) << 48)
+			| (static_cast<uint64_t>(itemType) << 56)
+			| (static_cast<uint64_t>(generation) << 59);
+	}
 
 	/// <summary>
-	/// The hash of the item.
+	/// The evaluation value of the packed data.
 	/// </summary>
-	uint64_t hash = 0;
+	/// <param name="data">The packed data</param>
+	/// <returns>The evaluation value</returns>
+	static int evaluationValue(uint64_t data) {
+		return static_cast<int32_t>(static_cast<uint32_t>(data));
+	}
 
 	/// <summary>
-	/// The evaluation value of the item.
+	/// The best move of the packed data.
 	/// </summary>
-	int evaluationValue = 0;
+	/// <param name="data">The packed data</param>
+	/// <returns>The best move</returns>
+	static Move bestMove(uint64_t data) {
+		return Move(static_cast<uint16_t>(data >> 32));
+	}
 
 	/// <summary>
-	/// The evaluation depth of the item.
+	/// The evaluation depth of the packed data.
 	/// </summary>
-	int evaluationDepth = 0;
+	/// <param name="data">The packed data</param>
+	/// <returns>The evaluation depth</returns>
+	static int evaluationDepth(uint64_t data) {
+		return static_cast<int>((data >> 48) & 0xFF);
+	}
 
 	/// <summary>
-	/// If the item was evaluated for white.
+	/// The item type of the packed data.
 	/// </summary>
-	bool evaluatedForWhite = true;
+	/// <param name="data">The packed data</param>
+	/// <returns>The item type</returns>
+	static TranspositionTableItemType itemType(uint64_t data) {
+		return static_cast<TranspositionTableItemType>((data >> 56) & 0x3);
+	}
 
 	/// <summary>
-	/// The best move of the item.
+	/// The search generation of the packed data.
 	/// </summary>
-	Move bestMove = Move(0, 0, 0, 0);
+	/// <param name="data">The packed data</param>
+	/// <returns>The search generation</returns>
+	static int generation(uint64_t data) {
+		return static_cast<int>(data >> 59);
+	}
+};
 
+/// <summary>
+/// A struct describing a cache-line-sized group of transposition table entries.
+/// A game state can be stored to any entry of the bucket its hash maps to.
+/// </summary>
+struct alignas(64) TranspositionTableBucket {
+	/// <summary>
+	/// The entries of the bucket.
+	/// </summary>
+	TranspositionTableEntry entries[TRANSPOSITION_TABLE_BUCKET_SIZE];
 };
 
 /// <summary>
-/// A template class describing a transposition table of the given size.
+/// A class describing a transposition table whose size is set at runtime.
+/// The table is lock-free: the entries are read and written with relaxed atomic operations on 64-bit words
+/// and verified with the XOR of the key and data words.
+/// The amount of buckets is a power of two, so the bucket of a hash is found with a bit mask.
 /// </summary>
-/// <typeparam name="Size">The amount of items that the table can store</typeparam>
-template <size_t Size>
 class TranspositionTable {
 
 private:
 	/// <summary>
-	/// The transposition table items.
+	/// The transposition table buckets, or null if the table is not allocated.
+	/// </summary>
+	TranspositionTableBucket* _buckets = nullptr;
+
+	/// <summary>
+	/// The amount of buckets in the table (a power of two).
+	/// </summary>
+	size_t _bucketCount = 0;
+
+	/// <summary>
+	/// The current search generation. Items stored at older generations are preferred when replacing items.
+	/// </summary>
+	int _generation = 0;
+
+	/// <summary>
+	/// The bucket of the given hash.
+	/// </summary>
+	/// <param name="hash">The hash of the game state</param>
+	/// <returns>The bucket</returns>
+	TranspositionTableBucket& bucket(uint64_t hash) {
+		return _buckets[hash & (_bucketCount - 1)];
+	}
+
+	/// <summary>
+	/// Frees the memory of the table.
 	/// </summary>
-	std::atomic<TranspositionTableItem> _items[Size];
-	
+	void free();
+
 public:
+	/// <summary>
+	/// Creates a transposition table without allocating memory.
+	/// The table must be allocated with resize before use.
+	/// </summary>
+	TranspositionTable() = default;
+
+	/// <summary>
+	/// Frees the memory of the table.
+	/// </summary>
+	~TranspositionTable();
+
+	TranspositionTable(const TranspositionTable&) = delete;
+	TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+	/// <summary>
+	/// Reallocates the table to the given size and clears it. The size is rounded down to a power of two
+	/// (at least one bucket). On Linux the memory is backed with transparent huge pages when possible.
+	/// If the allocation fails, smaller tables are tried. The old table is kept if no new table can be allocated,
+	/// and std::bad_alloc is thrown only if there is no old table.
+	/// Must not be called while the table is in use.
+	/// </summary>
+	/// <param name="megabytes">The size of the table in megabytes</param>
+	/// <returns>The size of the table in megabytes after resizing</returns>
+	size_t resize(size_t megabytes);
+
+	/// <summary>
+	/// Removes all items from the table. The table is cleared in parallel with the given amount of threads.
+	/// Must not be called while the table is in use.
+	/// </summary>
+	/// <param name="threadCount">The amount of threads to clear the table with</param>
+	void clear(int threadCount);
+
+	/// <summary>
+	/// Information about if the table is allocated.
+	/// </summary>
+	/// <returns>True if the table is allocated</returns>
+	bool isAllocated() const {
+		return _buckets != nullptr;
+	}
+
+	/// <summary>
+	/// Starts a new search generation. Should be called at the start of every best move search,
+	/// so the items of the earlier searches are replaced before the items of the current search.
+	/// </summary>
+	void newSearch() {
+		_generation = (_generation + 1) % TRANSPOSITION_TABLE_GENERATIONS;
+	}
+
+	/// <summary>
+	/// Estimates how full the table is with items of the current search generation.
+	/// The estimate is calculated from a sample of the first 1000 entries.
+	/// </summary>
+	/// <returns>The amount of used entries per mille</returns>
+	int hashfull() const;
+
 	/// <summary>
 	/// Handles storing the given game state with the given evaluation value, depth and item type.
-	/// Handles collisions in the table by replacing the older item.
-	/// Doesn't replace any items with higher depth than the given depth.
-	/// The function is thread safe as it uses atomic operations.
+	/// Replaces the item of the same game state if it is from an earlier search or doesn't have higher depth than the given depth.
+	/// Otherwise replaces the item with the lowest depth in the bucket of the game state, an item from an earlier
+	/// search counting as shallower by 8 plies for every generation it is older.
+	/// The function is thread safe as it doesn't need locking.
 	/// </summary>
 	/// <param name="state">The game state to store</param>
-	/// <param name="evaluationValue">The evaluation value</param>
+	/// <param name="evaluationValue">The evaluation value from the perspective of the side to move</param>
 	/// <param name="evaluationDepth">The evaluation depth</param>
-	/// <param name="evaluatedForWhite">If the game state was evaluated for white</param>
 	/// <param name="itemType">The item type</param>
 	/// <param name="bestMove">The best move</param>
-	void store(const GameState& state, int evaluationValue, int evaluationDepth, bool evaluatedForWhite, TranspositionTableItemType itemType, const Move& bestMove);
+	void store(const GameState& state, int evaluationValue, int evaluationDepth, TranspositionTableItemType itemType, const Move& bestMove);
 
 	/// <summary>
 	/// Performs a table lookup with the given game state and minimum depth.
-	/// If an item with at least the minimum depth and the same hash with the given game state is found,
-	/// sets the evaluation value and item type of the item to the reference parameter variables.
-	/// The function is thread safe as it uses atomic operations.
+	/// If an item with the same hash with the given game state is found, sets its best move to the reference parameter,
+	/// and if the item also has at least the minimum depth, sets its evaluation value and item type to the reference parameters.
+	/// The function is thread safe as it doesn't need locking.
 	/// </summary>
 	/// <param name="state">The game state to lookup</param>
 	/// <param name="minDepth">The minumum depth to lookup</param>
-	/// <param name="evaluateForWhite">If the lookup should search result for white (or black)</param>
-	/// <param name="evaluationValue">Reference parameter that gets the evaluation value if an item is found</param>
-	/// <param name="bestMove">Reference parameter that gets the best move if an item is found</param>
+	/// <param name="evaluationValue">Reference parameter that gets the evaluation value from the perspective of the side to move if an item is found</param>
+	/// <param name="bestMove">Reference parameter that gets the best move if an item is found, even if the item is too shallow</param>
 	/// <param name="itemType">Reference parameter that gets the item type if an item is found</param>
-	/// <returns>True if an item was found and the reference parameters were updated</returns>
-	bool lookup(const GameState& state, int minDepth, bool evaluateForWhite, int& evaluationValue, Move& bestMove, TranspositionTableItemType& itemType);
+	/// <returns>True if an item with at least the minimum depth was found and its evaluation value and item type were set</returns>
+	bool lookup(const GameState& state, int minDepth, int& evaluationValue, Move& bestMove, TranspositionTableItemType& itemType);
 
 };
 
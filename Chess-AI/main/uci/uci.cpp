@@ -0,0 +1,405 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "uci.h"
+#include "../gameState/gameState.h"
+#include "../move.h"
+#include "../moveList.h"
+#include "../chessAI.h"
+#include "../perft.h"
+#include "../bench.h"
+
+/// <summary>
+/// The mutex protecting the standard output, as the search thread writes its output while the commands are handled.
+/// </summary>
+std::mutex uciOutputMutex;
+
+/// <summary>
+/// The value of the Hash option (the transposition table size in megabytes).
+/// </summary>
+int uciHashSize = DEFAULT_TRANSPOSITION_TABLE_SIZE;
+
+/// <summary>
+/// The largest value of the Hash option in megabytes.
+/// </summary>
+constexpr auto UCI_MAX_HASH_SIZE = 65536;
+
+/// <summary>
+/// The value of the Threads option, or 0 if the option has not been set (the search uses all hardware threads).
+/// </summary>
+int uciThreadCount = 0;
+
+/// <summary>
+/// Handles the given command line.
+/// </summary>
+/// <param name="line">The command line</param>
+/// <param name="gameState">The current game state</param>
+/// <returns>False if the command was quit</returns>
+bool handleCommand(const std::string& line, GameState& gameState);
+
+/// <summary>
+/// Writes the given line to the standard output and flushes it.
+/// </summary>
+/// <param name="line">The line to write</param>
+void sendLine(const std::string& line);
+
+/// <summary>
+/// Resizes the transposition table to the value of the Hash option.
+/// Sends an info string if the table could not be allocated or had to be made smaller.
+/// </summary>
+void applyHashSize();
+
+/// <summary>
+/// Handles the uci command by sending the engine identification and the supported options.
+/// </summary>
+void handleUciCommand();
+
+/// <summary>
+/// Handles the setoption command. The search must not be running.
+/// </summary>
+/// <param name="input">The input stream of the command after the command name</param>
+void handleSetOption(std::istringstream& input);
+
+/// <summary>
+/// Handles the position command by setting the given game state to the described position.
+/// </summary>
+/// <param name="input">The input stream of the command after the command name</param>
+/// <param name="gameState">The game state to set</param>
+void handlePosition(std::istringstream& input, GameState& gameState);
+
+/// <summary>
+/// Handles the go command by starting a background search for the given game state.
+/// </summary>
+/// <param name="input">The input stream of the command after the command name</param>
+/// <param name="gameState">The game state to search move for</param>
+void handleGo(std::istringstream& input, GameState& gameState);
+
+/// <summary>
+/// Handles the perft command. "perft &lt;depth&gt;" writes the perft node counts of the moves of the given game state
+/// and "perft suite" runs the built-in perft suite. The search must not be running.
+/// </summary>
+/// <param name="input">The input stream of the command after the command name</param>
+/// <param name="gameState">The game state to run perft for</param>
+void handlePerft(std::istringstream& input, GameState& gameState);
+
+/// <summary>
+/// Handles the bench command by running the bench with the given depth (or the default depth)
+/// and restoring the Hash and Threads options afterwards. The search must not be running.
+/// </summary>
+/// <param name="input">The input stream of the command after the command name</param>
+void handleBench(std::istringstream& input);
+
+/// <summary>
+/// Makes the given move in UCI notation on the given game state if it is legal.
+/// </summary>
+/// <param name="gameState">The game state to make the move on</param>
+/// <param name="moveString">The move in UCI notation (for example "e2e4" or "e7e8q")</param>
+/// <returns>True if the move was legal and made</returns>
+bool makeUciMove(GameState& gameState, const std::string& moveString);
+
+/// <summary>
+/// Formats the given search progress as an UCI info line.
+/// </summary>
+/// <param name="info">The search progress</param>
+/// <returns>The info line</returns>
+std::string searchInfoToString(const SearchInfo& info);
+
+void startUci(int argc, char* argv[]) {
+	GameState gameState;
+
+	// Run the command given as command line arguments and exit, or read the commands from the standard input
+	if (argc > 1) {
+		std::string line;
+		for (int i = 1; i < argc; i++) {
+			line += std::string(i > 1 ? " " : "") + argv[i];
+		}
+		handleCommand(line, gameState);
+	}
+	else {
+		std::string line;
+		while (std::getline(std::cin, line) && handleCommand(line, gameState)) {}
+	}
+
+	// Stop the search before exiting (also when the input is closed without the quit command)
+	ChessAI::stop();
+	ChessAI::waitForSearch();
+}
+
+bool handleCommand(const std::string& line, GameState& gameState) {
+	std::istringstream input(line);
+	std::string command;
+	input >> command;
+
+	if (command == "uci") {
+		handleUciCommand();
+	}
+	else if (command == "isready") {
+		sendLine("readyok");
+	}
+	else if (command == "setoption") {
+		// The options can't be changed while searching
+		ChessAI::stop();
+		ChessAI::waitForSearch();
+		handleSetOption(input);
+	}
+	else if (command == "ucinewgame") {
+		ChessAI::stop();
+		ChessAI::waitForSearch();
+		ChessAI::clearTranspositionTable();
+		ChessAI::clearSearchHistory();
+		gameState = GameState();
+	}
+	else if (command == "position") {
+		handlePosition(input, gameState);
+	}
+	else if (command == "go") {
+		handleGo(input, gameState);
+	}
+	else if (command == "perft") {
+		ChessAI::stop();
+		ChessAI::waitForSearch();
+		handlePerft(input, gameState);
+	}
+	else if (command == "bench") {
+		ChessAI::stop();
+		ChessAI::waitForSearch();
+		handleBench(input);
+	}
+	else if (command == "stop") {
+		ChessAI::stop();
+	}
+	else if (command == "ponderhit") {
+		ChessAI::ponderhit();
+	}
+	else if (command == "quit") {
+		return false;
+	}
+
+	return true;
+}
+
+void sendLine(const std::string& line) {
+	std::lock_guard<std::mutex> lock(uciOutputMutex);
+	std::cout << line << std::endl;
+}
+
+void applyHashSize() {
+	try {
+		int size = ChessAI::setTranspositionTableSize(uciHashSize);
+		// The size is always rounded down to a power of two, so only a table of at most half the size is a fallback
+		if (size * 2 <= uciHashSize) {
+			sendLine("info string Could not allocate " + std::to_string(uciHashSize) + " MB for the hash table, using "
+				+ std::to_string(size) + " MB");
+		}
+	}
+	catch (const std::bad_alloc&) {
+		sendLine("info string Could not allocate the hash table");
+	}
+}
+
+void handleUciCommand() {
+	std::ostringstream output;
+	output << "id name " << UCI_ENGINE_NAME << "\n";
+	output << "id author " << UCI_ENGINE_AUTHOR << "\n";
+	output << "option name Hash type spin default " << DEFAULT_TRANSPOSITION_TABLE_SIZE << " min 1 max " << UCI_MAX_HASH_SIZE << "\n";
+	output << "option name Threads type spin default " << std::max(1u, std::thread::hardware_concurrency()) << " min 1 max 512\n";
+	output << "option name Ponder type check default false\n";
+	output << "option name Clear Hash type button\n";
+	output << "uciok";
+	sendLine(output.str());
+}
+
+void handleSetOption(std::istringstream& input) {
+	// The option name can contain spaces, so it continues until the value token
+	std::string token, name, value;
+	input >> token;
+	if (token != "name") {
+		return;
+	}
+	while (input >> token && token != "value") {
+		name += (name.empty() ? "" : " ") + token;
+	}
+	std::getline(input >> std::ws, value);
+
+	if (name == "Hash") {
+		uciHashSize = static_cast<int>(std::clamp(std::atoll(value.c_str()), 1LL, static_cast<long long>(UCI_MAX_HASH_SIZE)));
+		applyHashSize();
+	}
+	else if (name == "Threads") {
+		uciThreadCount = std::max(1, std::atoi(value.c_str()));
+		ChessAI::setThreadCount(uciThreadCount);
+	}
+	else if (name == "Clear Hash") {
+		ChessAI::clearTranspositionTable();
+	}
+}
+
+void handlePosition(std::istringstream& input, GameState& gameState) {
+	std::string token;
+	input >> token;
+	if (token == "startpos") {
+		gameState = GameState();
+		input >> token;
+	}
+	else if (token == "fen") {
+		// The FEN fields continue until the moves token
+		std::string fen;
+		while (input >> token && token != "moves") {
+			fen += token + " ";
+		}
+		if (!GameState::fromFEN(fen, gameState)) {
+			sendLine("info string Invalid FEN: " + fen);
+			return;
+		}
+	}
+	else {
+		sendLine("info string Unsupported position: " + token);
+		return;
+	}
+
+	// Make the moves played from the position
+	if (token != "moves") {
+		return;
+	}
+	while (input >> token) {
+		if (!makeUciMove(gameState, token)) {
+			sendLine("info string Illegal move: " + token);
+			return;
+		}
+	}
+}
+
+void handleGo(std::istringstream& input, GameState& gameState) {
+	SearchLimits limits;
+	int whiteTime = -1, blackTime = -1, whiteIncrement = 0, blackIncrement = 0, movesToGo = UCI_DEFAULT_MOVES_TO_GO, moveTime = -1;
+	bool depthSet = false;
+
+	std::string token;
+	while (input >> token) {
+		if (token == "perft") {
+			// "go perft <depth>" is the perft command of the common engines
+			ChessAI::stop();
+			ChessAI::waitForSearch();
+			handlePerft(input, gameState);
+			return;
+		}
+		else if (token == "wtime") input >> whiteTime;
+		else if (token == "btime") input >> blackTime;
+		else if (token == "winc") input >> whiteIncrement;
+		else if (token == "binc") input >> blackIncrement;
+		else if (token == "movestogo") input >> movesToGo;
+		else if (token == "movetime") input >> moveTime;
+		else if (token == "depth") {
+			input >> limits.maxDepth;
+			depthSet = true;
+		}
+		else if (token == "infinite") limits.infinite = true;
+		else if (token == "ponder") limits.ponder = true;
+	}
+
+	// Calculate the time limit from the clock of the side to move
+	bool isWhite = gameState.isWhiteSideToMove();
+	int time = isWhite ? whiteTime : blackTime;
+	int increment = isWhite ? whiteIncrement : blackIncrement;
+	if (moveTime >= 0) {
+		limits.timeLimit = std::max(1, moveTime - UCI_MOVE_OVERHEAD);
+	}
+	else if (time >= 0) {
+		int timeLimit = time / std::max(1, movesToGo) + increment * 3 / 4;
+		limits.timeLimit = std::max(1, std::min(timeLimit, time - UCI_MOVE_OVERHEAD));
+	}
+	else if (!depthSet) {
+		// A go command without any limits searches until stopped
+		limits.infinite = true;
+	}
+	if (limits.infinite) {
+		limits.timeLimit = 0;
+	}
+
+	limits.infoCallback = [](const SearchInfo& info) {
+		sendLine(searchInfoToString(info));
+	};
+
+	ChessAI::startSearch(gameState, limits, [](const SearchResult& result) {
+		if (result.bestMove == Move(0, 0, 0, 0)) {
+			sendLine("bestmove 0000");
+			return;
+		}
+
+		// The second move of the principal variation is the expected reply to ponder on
+		std::string line = "bestmove " + result.bestMove.toString();
+		if (result.principalVariation.size() > 1) {
+			line += " ponder " + result.principalVariation[1].toString();
+		}
+		sendLine(line);
+	});
+}
+
+void handlePerft(std::istringstream& input, GameState& gameState) {
+	std::string argument;
+	input >> argument;
+
+	std::lock_guard<std::mutex> lock(uciOutputMutex);
+	if (argument == "suite") {
+		runPerftSuite(std::cout);
+	}
+	else {
+		perftDivide(gameState, std::max(1, std::atoi(argument.c_str())), std::cout);
+	}
+}
+
+void handleBench(std::istringstream& input) {
+	int depth = BENCH_DEFAULT_DEPTH;
+	input >> depth;
+
+	{
+		std::lock_guard<std::mutex> lock(uciOutputMutex);
+		runBench(std::max(1, depth), std::cout);
+	}
+
+	// Restore the options changed by the bench
+	applyHashSize();
+	ChessAI::setThreadCount(uciThreadCount > 0 ? uciThreadCount : static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+bool makeUciMove(GameState& gameState, const std::string& moveString) {
+	// Use the generated legal move, as the parsed move doesn't have the capture, castling and en passant flags
+	Move move(moveString);
+	MoveList legalMoves;
+	gameState.legalMoves(legalMoves);
+	for (const Move& legalMove : legalMoves) {
+		if (legalMove.matches(move)) {
+			UndoRecord undo;
+			gameState.makeMove(legalMove, undo);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+std::string searchInfoToString(const SearchInfo& info) {
+	std::ostringstream output;
+	output << "info depth " << info.depth;
+	if (info.mateIn != 0) {
+		output << " score mate " << info.mateIn;
+	}
+	else {
+		output << " score cp " << info.score;
+	}
+	output << " nodes " << info.nodes;
+	output << " nps " << info.nodes * 1000 / std::max(1LL, info.time);
+	output << " time " << info.time;
+	output << " hashfull " << info.hashfull;
+	output << " pv";
+	for (const Move& move : info.principalVariation) {
+		output << " " << move.toString();
+	}
+	return output.str();
+}
@@ -0,0 +1,34 @@
+#ifndef UCI_H
+#define UCI_H
+
+/// <summary>
+/// The name of the engine reported to UCI clients.
+/// </summary>
+constexpr auto UCI_ENGINE_NAME = "Chesstinator";
+
+/// <summary>
+/// The author of the engine reported to UCI clients.
+/// </summary>
+constexpr auto UCI_ENGINE_AUTHOR = "laurihuju";
+
+/// <summary>
+/// The time in milliseconds that is left unused from the clock of the engine to cover the communication delays.
+/// </summary>
+constexpr auto UCI_MOVE_OVERHEAD = 50;
+
+/// <summary>
+/// The amount of moves the remaining time is divided for if the client doesn't tell the amount of moves to the next time control.
+/// </summary>
+constexpr auto UCI_DEFAULT_MOVES_TO_GO = 30;
+
+/// <summary>
+/// Starts the engine with the Universal Chess Interface protocol.
+/// Reads the commands from the standard input and writes the responses to the standard output until the quit command.
+/// The searches run in the background, so the commands are handled while searching.
+/// If command line arguments are given, they are handled as one command (for example "bench") and the engine exits.
+/// </summary>
+/// <param name="argc">The amount of command line arguments</param>
+/// <param name="argv">The command line arguments</param>
+void startUci(int argc, char* argv[]);
+
+#endif
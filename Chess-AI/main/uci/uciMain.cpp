@@ -0,0 +1,5 @@
+#include "uci.h"
+
+int main(int argc, char* argv[]) {
+	startUci(argc, argv);
+}